@@ -0,0 +1,73 @@
+#include "BenchReport.h"  // Include the header file for the benchmark report.
+#include <cmath>          // Include `std::abs`.
+#include <cstdlib>        // Include `std::strtod`.
+#include <cstring>        // Include `std::strchr`.
+#include <fstream>        // Include file streams for the baseline.
+#include <iomanip>        // Include stream manipulators for fixed precision.
+
+// Write the results as JSON, one result object per line.
+void writeJson(std::ostream& out, const std::vector<BenchResult>& results, unsigned seed, const std::string& simd) {
+    out << "{\n  \"version\": 1,\n  \"seed\": " << seed << ",\n  \"simd\": \"" << simd << "\",\n  \"results\": [\n";
+    out << std::setprecision(6) << std::fixed;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"bodies\": " << r.bodies << ", \"density\": " << r.density
+            << ", \"reps\": " << r.reps << ", \"median_ms\": " << r.medianMs << ", \"min_ms\": " << r.minMs
+            << ", \"work\": " << r.work << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Find `"key": ` in a line and return the text right after it (nullptr if absent).
+static const char* findValue(const std::string& line, const char* key) {
+    std::string pattern = std::string("\"") + key + "\": ";
+    std::size_t pos = line.find(pattern);
+    return pos == std::string::npos ? nullptr : line.c_str() + pos + pattern.size();
+}
+
+// Read results written by `writeJson` (one result object per line).
+bool readJson(const std::string& path, std::vector<BenchResult>& results) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        const char* name = findValue(line, "name");
+        if (!name || *name != '"') continue;  // Not a result line.
+
+        BenchResult r;
+        const char* nameEnd = std::strchr(name + 1, '"');
+        if (!nameEnd) continue;
+        r.name.assign(name + 1, nameEnd);
+        if (const char* v = findValue(line, "bodies")) r.bodies = std::strtoull(v, nullptr, 10);
+        if (const char* v = findValue(line, "density")) r.density = std::strtod(v, nullptr);
+        if (const char* v = findValue(line, "reps")) r.reps = std::strtoull(v, nullptr, 10);
+        if (const char* v = findValue(line, "median_ms")) r.medianMs = std::strtod(v, nullptr);
+        if (const char* v = findValue(line, "min_ms")) r.minMs = std::strtod(v, nullptr);
+        if (const char* v = findValue(line, "work")) r.work = std::strtod(v, nullptr);
+        results.push_back(r);
+    }
+    return true;
+}
+
+// Print the regressions beyond the threshold.
+std::size_t compareResults(std::ostream& out, const std::vector<BenchResult>& baseline,
+                           const std::vector<BenchResult>& current, double threshold) {
+    std::size_t regressions = 0;
+    for (const BenchResult& now : current) {
+        for (const BenchResult& before : baseline) {
+            if (before.name != now.name || before.bodies != now.bodies || std::abs(before.density - now.density) > 1e-6) {
+                continue;
+            }
+            if (before.medianMs <= 0.0) break;
+            double change = now.medianMs / before.medianMs - 1.0;
+            bool regressed = change > threshold;
+            out << (regressed ? "REGRESSION " : "ok         ") << now.name << " bodies=" << now.bodies
+                << " density=" << now.density << ": " << before.medianMs << " ms -> " << now.medianMs << " ms ("
+                << std::showpos << change * 100.0 << std::noshowpos << "%)\n";
+            if (regressed) ++regressions;
+            break;
+        }
+    }
+    return regressions;
+}
@@ -0,0 +1,31 @@
+#ifndef BENCH_REPORT_H  // Include guard to prevent multiple inclusions of this header file.
+#define BENCH_REPORT_H  // Define the macro `BENCH_REPORT_H` to ensure the file is included only once.
+
+#include <cstddef>  // Include `std::size_t`.
+#include <ostream>  // Include output streams for the JSON writer.
+#include <string>   // Include STL string for names and paths.
+#include <vector>   // Include STL vector for the result list.
+
+// Timing of one stage on one scene.
+struct BenchResult {
+    std::string name;        // Stage name (e.g. "integrate", "broadphase_sap", "step").
+    std::size_t bodies = 0;  // Number of bodies of the scene (0 for scene-independent stages).
+    double density = 0.0;    // Density of the scene.
+    std::size_t reps = 0;    // Number of timed repetitions.
+    double medianMs = 0.0;   // Median time of one repetition, in milliseconds.
+    double minMs = 0.0;      // Fastest repetition, in milliseconds.
+    double work = 0.0;       // Stage-specific amount of work (pairs found, collisions resolved, ...).
+};
+
+// Write the results as JSON, one result object per line so files diff well across commits.
+void writeJson(std::ostream& out, const std::vector<BenchResult>& results, unsigned seed, const std::string& simd);
+
+// Read results written by `writeJson`. Returns false if the file cannot be read.
+bool readJson(const std::string& path, std::vector<BenchResult>& results);
+
+// Print the stages whose median got slower than the baseline by more than `threshold` (0.1 = 10%).
+// Returns the number of regressions.
+std::size_t compareResults(std::ostream& out, const std::vector<BenchResult>& baseline,
+                           const std::vector<BenchResult>& current, double threshold);
+
+#endif // BENCH_REPORT_H  // End of the include guard.
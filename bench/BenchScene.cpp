@@ -0,0 +1,59 @@
+#include "BenchScene.h"                          // Include the header file for the benchmark scenes.
+#include "../src/obj/abs/enum/gravity_constants.h"  // Include the gravity of the planets.
+#include <cmath>                                 // Include `std::sqrt`, `std::cos`, `std::sin`.
+#include <random>                                // Include the seeded random generator.
+
+// Average area of a body's bounding box for sizes uniform in [4, 8]: E[s^2] = 112 / 3.
+static constexpr float MEAN_BODY_AREA = 112.0f / 3.0f;
+
+// Generate the scene body by body from the seed; the generator is fully specified so scenes match across platforms.
+sf::Vector2f buildScene(BodyStore& bodies, const SceneSpec& spec) {
+    bodies.clear();
+
+    // World with a 4:3 aspect ratio whose area gives the requested coverage.
+    const float area = spec.bodies * MEAN_BODY_AREA / spec.density;
+    const float height = std::sqrt(area * 3.0f / 4.0f);
+    const sf::Vector2f world(height * 4.0f / 3.0f, height);
+
+    std::mt19937 rng(spec.seed);
+    auto uniform = [&rng](float lo, float hi) {  // Portable uniform float (std distributions are implementation-defined).
+        return lo + (hi - lo) * static_cast<float>(rng() >> 8) / static_cast<float>(1u << 24);
+    };
+    const float gravities[] = {GRAVITY_EARTH, GRAVITY_MOON, GRAVITY_MARS};
+    const sf::Color colors[] = {sf::Color::Red, sf::Color::Blue, sf::Color::Green};
+
+    for (std::size_t i = 0; i < spec.bodies; ++i) {
+        const ShapeKind kind = static_cast<ShapeKind>(i % 3);  // Equal mix of circles, squares and triangles.
+        const float size = uniform(4.0f, 8.0f);
+        const sf::Vector2f position(uniform(0.0f, world.x - size), uniform(0.0f, world.y - size));
+        const std::size_t id = bodies.add(kind, position, {size, size}, colors[i % 3]);
+
+        const float mass = uniform(0.5f, 2.0f);
+        const float angle = uniform(0.0f, 6.2831853f);
+        bodies.setMass(id, mass);
+        bodies.velX[id] = 100.0f * std::cos(angle);  // Same initial speed as `Object::setInitialAngle`.
+        bodies.velY[id] = 100.0f * std::sin(angle);
+        bodies.accY[id] = gravities[i % 3] * mass;   // Same force term as `Object::setGravity`.
+    }
+    return world;
+}
+
+// Remember the mutable columns of the store.
+void SceneSnapshot::save(const BodyStore& bodies) {
+    columns = {bodies.posX, bodies.posY, bodies.velX, bodies.velY, bodies.extX, bodies.extY, bodies.scaleFactor,
+               bodies.minX, bodies.minY, bodies.maxX, bodies.maxY};
+    sleeping = bodies.sleeping;
+    stillFrames = bodies.stillFrames;
+}
+
+// Put the saved columns back.
+void SceneSnapshot::restore(BodyStore& bodies) const {
+    std::vector<float>* targets[] = {&bodies.posX, &bodies.posY, &bodies.velX, &bodies.velY, &bodies.extX,
+                                     &bodies.extY, &bodies.scaleFactor, &bodies.minX, &bodies.minY,
+                                     &bodies.maxX, &bodies.maxY};
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        *targets[i] = columns[i];
+    }
+    bodies.sleeping = sleeping;
+    bodies.stillFrames = stillFrames;
+}
@@ -0,0 +1,32 @@
+#ifndef BENCH_SCENE_H  // Include guard to prevent multiple inclusions of this header file.
+#define BENCH_SCENE_H  // Define the macro `BENCH_SCENE_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>              // Include SFML graphics for vectors.
+#include "../src/world/BodyStore.h"       // Include the body store the scenes are generated into.
+#include <cstdint>                        // Include fixed-width integer types for the seed.
+#include <vector>                         // Include STL vector for the saved columns.
+
+// Parameters of a generated benchmark scene.
+struct SceneSpec {
+    std::size_t bodies = 1000;  // Number of bodies.
+    float density = 0.1f;       // Fraction of the world area covered by bodies.
+    std::uint32_t seed = 1;     // Seed of the random generator: the same spec always gives the same scene.
+};
+
+// Replace the content of `bodies` with a seeded random mix of circles, squares and triangles
+// and return the size of the world that gives the requested density.
+sf::Vector2f buildScene(BodyStore& bodies, const SceneSpec& spec);
+
+// Copy of the mutable state of a scene, used to run a stage several times from the same state.
+class SceneSnapshot {
+public:
+    void save(const BodyStore& bodies);  // Remember positions, velocities, extents, bounds and sleep state.
+    void restore(BodyStore& bodies) const;  // Put them back (the store must have the same bodies).
+
+private:
+    std::vector<std::vector<float>> columns;
+    std::vector<std::uint8_t> sleeping;
+    std::vector<std::uint16_t> stillFrames;
+};
+
+#endif // BENCH_SCENE_H  // End of the include guard.
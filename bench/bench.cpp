@@ -0,0 +1,292 @@
+#include "BenchScene.h"                              // Include the seeded scene generator.
+#include "BenchReport.h"                             // Include the JSON report and baseline comparison.
+#include "../src/obj/abs/object.h"                   // Include `Object::bodies` and the collision routines.
+#include "../src/world/Integrator.h"                 // Include the batch integrator.
+#include "../src/world/broadphase/Broadphase.h"      // Include both broadphase backends.
+#include "../src/sim/Simulation.h"                   // Include the end-to-end physics step.
+#include "../src/world/gravity/BarnesHut.h"           // Include the mutual gravity.
+#include "../src/render/BodyRenderer.h"              // Include the batched geometry builder.
+#include "../src/capture/FrameCapture.h"             // Include the asynchronous video capture.
+#include <algorithm>                                 // Include `std::sort` and `std::min_element`.
+#include <chrono>                                    // Include the steady clock used for timing.
+#include <cstdio>                                    // Include `std::remove` for the temporary video.
+#include <cstdlib>                                   // Include `std::atoi` / `std::atof` for command-line parsing.
+#include <fstream>                                   // Include file streams for the report.
+#include <functional>                                // Include `std::function` for the timed bodies.
+#include <iostream>                                  // Include console output.
+#include <sstream>                                   // Include string streams for comma-separated lists.
+#include <string>                                    // Include STL string for command-line parsing.
+#include <vector>                                    // Include STL vector for the result list.
+
+// Options of a benchmark run.
+struct BenchOptions {
+    std::vector<std::size_t> sizes{1000, 10000, 100000, 1000000};  // Body counts.
+    std::vector<float> densities{0.05f, 0.2f, 0.5f};                // Fractions of the world covered by bodies.
+    std::size_t reps = 10;                                          // Timed repetitions per stage.
+    unsigned seed = 1;                                              // Seed of the scenes.
+    unsigned threads = 1;                                           // Threads of the end-to-end step (0 = all).
+    float deltaTime = 1.0f / 60.0f;                                 // Step used by every stage.
+    std::string output = "bench.json";                              // Report file.
+    std::string baseline;                                           // Report to compare against (empty = none).
+    double threshold = 0.1;                                         // Slowdown flagged as a regression.
+};
+
+// Parse a comma-separated list of numbers.
+template <typename T>
+static std::vector<T> parseList(const std::string& text) {
+    std::vector<T> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(static_cast<T>(std::atof(item.c_str())));
+    }
+    return values;
+}
+
+// Run `body` once untimed to warm caches, then `reps` times, with `setup` run untimed before each repetition.
+static BenchResult measure(const std::string& name, const SceneSpec& spec, std::size_t reps,
+                           const std::function<void()>& setup, const std::function<double()>& body) {
+    using Clock = std::chrono::steady_clock;
+    BenchResult result;
+    result.name = name;
+    result.bodies = spec.bodies;
+    result.density = spec.density;
+    result.reps = reps;
+
+    std::vector<double> times;
+    for (std::size_t rep = 0; rep <= reps; ++rep) {
+        if (setup) setup();
+        Clock::time_point start = Clock::now();
+        result.work = body();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (rep > 0) times.push_back(ms);  // Repetition 0 is the warm-up.
+    }
+
+    std::sort(times.begin(), times.end());
+    result.medianMs = times[times.size() / 2];
+    result.minMs = times.front();
+    std::cout << name << " bodies=" << spec.bodies << " density=" << spec.density << ": median "
+              << result.medianMs << " ms, min " << result.minMs << " ms" << std::endl;
+    return result;
+}
+
+// Time every stage of the pipeline in isolation on one scene.
+static void benchScene(const SceneSpec& spec, const BenchOptions& options, std::vector<BenchResult>& results) {
+    BodyStore& bodies = Object::bodies;
+    const sf::Vector2f world = buildScene(bodies, spec);
+    const float dt = options.deltaTime;
+
+    // Let the scene settle for a few steps so the stages see realistic overlaps, then keep that state.
+    Simulation settle;
+    settle.setWorldSize(world);
+    for (int i = 0; i < 3; ++i) settle.step(dt);
+    Object::staticObjects.clear();
+    SceneSnapshot snapshot;
+    snapshot.save(bodies);
+    auto restore = [&]() { snapshot.restore(bodies); };
+
+    // Integration with every instruction set the CPU supports.
+    const SimdLevel best = detectSimdLevel();
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse, SimdLevel::Avx2}) {
+        if (static_cast<int>(level) > static_cast<int>(best)) break;
+        results.push_back(measure(std::string("integrate_") + simdLevelName(level), spec, options.reps, restore, [&]() {
+            integrateBodies(bodies, 0, bodies.size(), dt, world, level);
+            return static_cast<double>(bodies.size());
+        }));
+    }
+
+    // Broadphase: the bodies move by one step between repetitions so the persistent sweep-and-prune
+    // sees the same small amount of reordering as in a running simulation.
+    std::vector<BodyPair> pairs;
+    for (BroadphaseType type : {BroadphaseType::SweepAndPrune, BroadphaseType::SpatialHash}) {
+        restore();
+        std::unique_ptr<Broadphase> broadphase = createBroadphase(type);
+        broadphase->findPairs(bodies, pairs);  // Initial sort, not part of the steady-state cost.
+        const char* name = type == BroadphaseType::SweepAndPrune ? "broadphase_sap" : "broadphase_grid";
+        results.push_back(measure(name, spec, options.reps, [&]() { integrateBodies(bodies, dt, world); }, [&]() {
+            broadphase->findPairs(bodies, pairs);
+            return static_cast<double>(pairs.size());
+        }));
+    }
+
+    // Narrowphase and resolution of the pairs of the saved state, serially.
+    restore();
+    createBroadphase(BroadphaseType::SweepAndPrune)->findPairs(bodies, pairs);
+    results.push_back(measure("resolve", spec, options.reps, [&]() { restore(); Object::staticObjects.clear(); }, [&]() {
+        std::size_t collisions = 0;
+        for (const BodyPair& pair : pairs) {
+            if (Object::checkCollision(pair.first, pair.second)) {
+                Object::resolveCollision(pair.first, pair.second);
+                ++collisions;
+            }
+        }
+        return static_cast<double>(collisions);
+    }));
+
+    // Geometry of a 1280x960 view of the world centre, scaled like a window showing the whole world.
+    restore();
+    BodyRenderer renderer;
+    const sf::FloatRect view(world.x / 4.0f, world.y / 4.0f, world.x / 2.0f, world.y / 2.0f);
+    results.push_back(measure("render_build", spec, options.reps, nullptr, [&]() {
+        renderer.build(bodies, view, 1280.0f / view.width);
+        return static_cast<double>(renderer.getVisibleCount());
+    }));
+
+    // Mutual gravity: tree build and evaluation, with the configured threads.
+    restore();
+    BarnesHutGravity gravity;
+    std::unique_ptr<JobSystem> jobs = options.threads != 1 ? std::make_unique<JobSystem>(options.threads) : nullptr;
+    results.push_back(measure("nbody_gravity", spec, options.reps, restore, [&]() {
+        gravity.apply(bodies, dt, jobs.get());
+        return static_cast<double>(gravity.getNodeCount());
+    }));
+
+    // Whole step: integration, broadphase and resolution with the configured threads.
+    Simulation simulation;
+    simulation.setWorldSize(world);
+    simulation.setThreadCount(options.threads);
+    results.push_back(measure("step", spec, options.reps, [&]() { restore(); Object::staticObjects.clear(); }, [&]() {
+        simulation.step(dt);
+        return static_cast<double>(simulation.getCollisionCount());
+    }));
+    Object::staticObjects.clear();
+}
+
+// Time the capture path on its own: submitting a 1280x720 frame, and the encoder throughput.
+static void benchCapture(const BenchOptions& options, std::vector<BenchResult>& results) {
+    const unsigned width = 1280, height = 720;
+    std::vector<std::uint8_t> frame(width * height * 4);
+    for (std::size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = static_cast<std::uint8_t>(i * 131 >> 3);  // Non-constant content so the codec does real work.
+    }
+
+    CaptureSettings settings;
+    settings.path = options.output + ".capture.avi";
+    settings.width = width;
+    settings.height = height;
+    settings.policy = CapturePolicy::Block;  // Every frame is encoded, so the close time is the encoder backlog.
+    const float framePeriod = static_cast<float>(1.0 / settings.fps);
+
+    // Each `capture` is preceded by one frame period on the capture clock, so exactly one frame is due.
+    auto submit = [&](FrameCapture& capture) {
+        capture.advance(framePeriod);
+        capture.capture(frame.data(), width, height);
+    };
+
+    // Cost of handing a frame to the encoder (includes waiting for a free buffer once the pool is full).
+    BenchResult submitResult;
+    {
+        FrameCapture capture(settings);
+        if (!capture.open()) {
+            std::cerr << "Warning: Failed to open the capture file, skipping the capture stages." << std::endl;
+            return;
+        }
+        SceneSpec none;
+        none.bodies = 0;
+        submitResult = measure("capture_submit", none, options.reps, nullptr, [&]() {
+            submit(capture);
+            return 1.0;
+        });
+        capture.close();
+        if (capture.framesEncoded() != options.reps + 1) {  // `measure` runs the body once more to warm up.
+            std::cerr << "Error: capture_submit encoded " << capture.framesEncoded() << " frames instead of "
+                      << options.reps + 1 << ", skipping the capture stages." << std::endl;
+            std::remove(settings.path.c_str());
+            return;
+        }
+    }
+
+    // Encoder throughput: queue a burst of frames into a fresh capture and wait for the encoder to drain it.
+    FrameCapture capture(settings);
+    if (!capture.open()) {
+        std::cerr << "Warning: Failed to open the capture file, skipping the capture stages." << std::endl;
+        return;
+    }
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < options.reps; ++i) {
+        submit(capture);
+    }
+    capture.close();  // Waits until the encoder has written everything.
+    const double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::remove(settings.path.c_str());
+    if (capture.framesEncoded() != options.reps) {
+        std::cerr << "Error: capture_encode encoded " << capture.framesEncoded() << " frames instead of "
+                  << options.reps << ", skipping the capture stages." << std::endl;
+        return;
+    }
+
+    BenchResult encode;
+    encode.name = "capture_encode";
+    encode.reps = options.reps;
+    encode.medianMs = elapsedMs / options.reps;
+    encode.minMs = encode.medianMs;  // Per-frame average of the burst.
+    encode.work = static_cast<double>(capture.framesEncoded());
+    results.push_back(submitResult);
+    results.push_back(encode);
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) {
+            options.sizes = parseList<std::size_t>(argv[++i]);  // Body counts, e.g. 1000,10000.
+        } else if (arg == "--densities" && hasValue) {
+            options.densities = parseList<float>(argv[++i]);  // Densities, e.g. 0.05,0.5.
+        } else if (arg == "--reps" && hasValue) {
+            options.reps = std::max(1, std::atoi(argv[++i]));  // Timed repetitions per stage.
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = static_cast<unsigned>(std::atoi(argv[++i]));  // Seed of the scenes.
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = static_cast<unsigned>(std::atoi(argv[++i]));  // Threads of the whole step.
+        } else if (arg == "--out" && hasValue) {
+            options.output = argv[++i];  // Report file.
+        } else if (arg == "--compare" && hasValue) {
+            options.baseline = argv[++i];  // Baseline report.
+        } else if (arg == "--threshold" && hasValue) {
+            options.threshold = std::atof(argv[++i]);  // Allowed slowdown (0.1 = 10%).
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--sizes N,N,...] [--densities D,D,...] [--reps N] [--seed S]"
+                      << " [--threads N] [--out FILE] [--compare BASELINE.json [--threshold 0.1]]" << std::endl;
+            return -1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for (std::size_t size : options.sizes) {
+        for (float density : options.densities) {
+            SceneSpec spec;
+            spec.bodies = size;
+            spec.density = density;
+            spec.seed = options.seed;
+            benchScene(spec, options, results);
+        }
+    }
+    Object::bodies.clear();
+    benchCapture(options, results);
+
+    std::ofstream out(options.output);
+    if (!out) {
+        std::cerr << "Error: Failed to write " << options.output << std::endl;
+        return -1;
+    }
+    writeJson(out, results, options.seed, simdLevelName(detectSimdLevel()));
+    std::cout << "Wrote " << results.size() << " results to " << options.output << std::endl;
+
+    // Regression check against a previous report.
+    if (!options.baseline.empty()) {
+        std::vector<BenchResult> baseline;
+        if (!readJson(options.baseline, baseline)) {
+            std::cerr << "Error: Failed to read " << options.baseline << std::endl;
+            return -1;
+        }
+        std::size_t regressions = compareResults(std::cout, baseline, results, options.threshold);
+        if (regressions > 0) {
+            std::cerr << regressions << " stage(s) regressed by more than " << options.threshold * 100.0 << "%" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -1,60 +1,309 @@
 #include "src/stcmIncludes.h"  // Include custom header file that likely contains class definitions and dependencies.
+#include <cstdlib>             // Include `std::atoi` / `std::atof` for command-line parsing.
+#include <memory>              // Include `std::unique_ptr` for the objects of the default scene.
+#include <string>              // Include STL string for command-line parsing.
+#include <vector>              // Include STL vector for the objects of the default scene.
 
-int main() {
-    // Create an SFML RenderWindow with a resolution of 800x600 pixels, titled "Physics Engine".
-    sf::RenderWindow window(sf::VideoMode(800, 600), "Physics Engine", sf::Style::Default);
+// Write the profiler trace to `path` if one was requested; returns the exit code of the program.
+static int writeTrace(const std::string& path) {
+#ifdef ENGN_PROFILING
+    if (!path.empty() && !Profiler::instance().writeChromeTrace(path)) {
+        std::cerr << "Error: Failed to write the trace to " << path << std::endl;
+        return -1;
+    }
+#else
+    (void)path;
+#endif
+    return 0;
+}
 
-    // Create physics objects: a circle, a square, and a triangle, each with specific properties.
-    Circle circle(50.0f, {100, 100}, sf::Color::Red);  // Circle with radius 50, position (100, 100), and red color.
-    Square square(100.0f, {300, 100}, sf::Color::Blue);  // Square with side length 100, position (300, 100), and blue color.
-    Triangle triangle(100.0f, {500, 100}, sf::Color::Green);  // Triangle with base/height 100, position (500, 100), and green color.
+// Create the default scene: a circle, a square, and a triangle, each with specific properties.
+static std::vector<std::unique_ptr<Object>> createScene() {
+    auto circle = std::make_unique<Circle>(50.0f, sf::Vector2f(100, 100), sf::Color::Red);  // Circle with radius 50, position (100, 100), and red color.
+    auto square = std::make_unique<Square>(100.0f, sf::Vector2f(300, 100), sf::Color::Blue);  // Square with side length 100, position (300, 100), and blue color.
+    auto triangle = std::make_unique<Triangle>(100.0f, sf::Vector2f(500, 100), sf::Color::Green);  // Triangle with base/height 100, position (500, 100), and green color.
 
     // Set gravitational forces for each object based on different planets.
-    circle.setGravity(Planets::Earth);  // Earth's gravity for the circle.
-    square.setGravity(Planets::Mars);  // Mars' gravity for the square.
-    triangle.setGravity(Planets::Sun);  // Sun's gravity for the triangle.
+    circle->setGravity(Planets::Earth);  // Earth's gravity for the circle.
+    square->setGravity(Planets::Mars);  // Mars' gravity for the square.
+    triangle->setGravity(Planets::Sun);  // Sun's gravity for the triangle.
 
     // Set mass for each object (all set to 1.0).
-    circle.setMass(1.0f);
-    square.setMass(1.0f);
-    triangle.setMass(1.0f);
+    circle->setMass(1.0f);
+    square->setMass(1.0f);
+    triangle->setMass(1.0f);
 
     // Set initial angles for each object (in degrees).
-    circle.setInitialAngle(45.0f);  // Circle starts at 45 degrees.
-    square.setInitialAngle(90.0f);  // Square starts at 90 degrees.
-    triangle.setInitialAngle(0.0f);  // Triangle starts at 0 degrees.
+    circle->setInitialAngle(45.0f);  // Circle starts at 45 degrees.
+    square->setInitialAngle(90.0f);  // Square starts at 90 degrees.
+    triangle->setInitialAngle(0.0f);  // Triangle starts at 0 degrees.
+
+    std::vector<std::unique_ptr<Object>> scene;
+    scene.push_back(std::move(circle));
+    scene.push_back(std::move(square));
+    scene.push_back(std::move(triangle));
+    return scene;
+}
+
+// Print the command-line options.
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--threads N] [--nondeterministic] [--debris-cap N] [--bake-debris]"
+              << " [--profile-trace FILE] [--profile-overlay] [--profile-font FILE] [--nbody G [--theta T]] [--no-sleep]"
+              << " [--step SECONDS] [--max-steps N] [--substeps N] [--no-ccd]"
+              << " [--restore FILE] [--checkpoint FILE [--checkpoint-every N]]"
+              << " [--headless [--steps N] [--dt SECONDS] [--width W] [--height H]"
+              << " [--record none|texture|cpu|log] [--output FILE]]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // Parse the command line. Without `--headless`, the simulation runs in a window as before.
+    bool headless = false;
+    unsigned threadCount = 1;    // Threads used by the physics step (0 = one per hardware thread).
+    bool deterministic = true;   // Whether multithreaded results must match the serial path bit-for-bit.
+    bool bakeDebris = false;     // Whether debris is baked into an accumulation texture.
+    std::string tracePath;       // Chrome trace written at exit (empty = none).
+    std::string fontPath = "/usr/share/fonts/truetype/dejavu/DejaVuSansMono.ttf";  // Font of the profiler panel.
+    bool showProfiler = false;   // Whether the profiler panel starts visible (F3 toggles it).
+    bool nbody = false;          // Whether bodies attract each other.
+    bool sleeping = true;        // Whether resting bodies are put to sleep.
+    unsigned substeps = 1;       // Substeps per physics step.
+    bool continuous = true;      // Whether fast bodies are swept against the others.
+    std::string restorePath;     // Snapshot the scene starts from (empty = default scene).
+    std::string checkpointPath;  // Snapshot rewritten periodically in the background (empty = none).
+    std::size_t checkpointEvery = 600;  // Steps between two checkpoints.
+    TimestepSettings timestepSettings;
+    NBodySettings nbodySettings;
+    HeadlessSettings headlessSettings;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--headless") {
+            headless = true;  // Simulate without a window.
+        } else if (arg == "--steps" && hasValue) {
+            headlessSettings.steps = std::strtoull(argv[++i], nullptr, 10);  // Number of steps to simulate.
+        } else if (arg == "--dt" && hasValue) {
+            headlessSettings.deltaTime = static_cast<float>(std::atof(argv[++i]));  // Fixed step in seconds.
+        } else if (arg == "--width" && hasValue) {
+            headlessSettings.worldSize.x = static_cast<float>(std::atof(argv[++i]));  // World width.
+        } else if (arg == "--height" && hasValue) {
+            headlessSettings.worldSize.y = static_cast<float>(std::atof(argv[++i]));  // World height.
+        } else if (arg == "--record" && hasValue) {
+            std::string mode = argv[++i];  // Where to rasterize recorded frames: none, texture, cpu or log.
+            if (mode == "texture") {
+                headlessSettings.raster = HeadlessRaster::RenderTexture;
+            } else if (mode == "cpu") {
+                headlessSettings.raster = HeadlessRaster::Cpu;
+            } else if (mode == "log") {
+                headlessSettings.raster = HeadlessRaster::StateLog;  // Also replaces the video of the window.
+            } else if (mode == "none") {
+                headlessSettings.raster = HeadlessRaster::None;
+            } else {
+                printUsage(argv[0]);  // Unknown mode.
+                return -1;
+            }
+        } else if (arg == "--threads" && hasValue) {
+            threadCount = static_cast<unsigned>(std::atoi(argv[++i]));  // Threads used by the physics step.
+        } else if (arg == "--nondeterministic") {
+            deterministic = false;  // Allow thread-count dependent results for extra speed.
+        } else if (arg == "--debris-cap" && hasValue) {
+            Object::staticObjects.setCapacity(std::strtoull(argv[++i], nullptr, 10));  // Maximum live debris.
+        } else if (arg == "--bake-debris") {
+            bakeDebris = true;  // Paint debris once into a texture instead of keeping it.
+        } else if (arg == "--profile-trace" && hasValue) {
+            tracePath = argv[++i];  // Write every profiled stage as a Chrome trace at exit.
+        } else if (arg == "--profile-overlay") {
+            showProfiler = true;  // Show the rolling p50/p99 of every stage.
+        } else if (arg == "--profile-font" && hasValue) {
+            fontPath = argv[++i];  // Font of the profiler panel.
+        } else if (arg == "--nbody" && hasValue) {
+            nbody = true;  // Mutual gravity with the given gravitational constant.
+            nbodySettings.gravityConstant = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--no-sleep") {
+            sleeping = false;  // Keep simulating bodies at rest.
+        } else if (arg == "--theta" && hasValue) {
+            nbodySettings.theta = static_cast<float>(std::atof(argv[++i]));  // Barnes–Hut opening angle.
+        } else if (arg == "--step" && hasValue) {
+            timestepSettings.step = static_cast<float>(std::atof(argv[++i]));  // Fixed physics step of the window.
+        } else if (arg == "--max-steps" && hasValue) {
+            timestepSettings.maxStepsPerFrame = static_cast<unsigned>(std::atoi(argv[++i]));  // Catch-up limit per frame.
+        } else if (arg == "--substeps" && hasValue) {
+            substeps = static_cast<unsigned>(std::atoi(argv[++i]));  // Split every step into N substeps.
+        } else if (arg == "--no-ccd") {
+            continuous = false;  // Only test overlaps at the end of each substep.
+        } else if (arg == "--restore" && hasValue) {
+            restorePath = argv[++i];  // Start from a saved scene instead of the default one.
+        } else if (arg == "--checkpoint" && hasValue) {
+            checkpointPath = argv[++i];  // Keep a snapshot of the running scene up to date.
+        } else if (arg == "--checkpoint-every" && hasValue) {
+            checkpointEvery = std::strtoull(argv[++i], nullptr, 10);  // Steps between two checkpoints.
+        } else if (arg == "--output" && hasValue) {
+            headlessSettings.capture.path = argv[++i];  // Output video (or state log) file.
+            headlessSettings.stateLog.path = headlessSettings.capture.path;
+        } else {
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
+
+#ifdef ENGN_PROFILING
+    ENGN_PROFILE_THREAD("main");
+    Profiler::instance().setTracing(!tracePath.empty());
+#else
+    if (!tracePath.empty() || showProfiler) {
+        std::cerr << "Warning: Built without ENGN_PROFILING, profiling options are ignored." << std::endl;
+    }
+#endif
+
+    // Start from a snapshot (bodies, debris and step count) or from the default scene.
+    SnapshotInfo restored;
+    std::vector<std::unique_ptr<Object>> scene;
+    if (!restorePath.empty()) {
+        if (!loadScene(restorePath, restored)) {
+            return -1;  // The reason was printed by `loadScene`.
+        }
+        headlessSettings.worldSize = restored.worldSize;
+        headlessSettings.firstStep = restored.step;
+        std::cout << "Restored " << Object::bodies.size() << " bodies at step " << restored.step << std::endl;
+    } else {
+        scene = createScene();
+    }
+
+    // Add all objects to the simulation (use `BroadphaseType::SpatialHash` for uniform-density scenes).
+    Simulation simulation(BroadphaseType::SweepAndPrune);
+    for (auto& obj : scene) {
+        simulation.add(*obj);
+    }
+    simulation.setThreadCount(threadCount);
+    simulation.setDeterministic(deterministic);
+    if (nbody) {
+        simulation.setNBodyGravity(nbodySettings);
+    }
+    SleepSettings sleepSettings;
+    sleepSettings.enabled = sleeping;
+    simulation.setSleep(sleepSettings);
+    simulation.setSubsteps(substeps);
+    simulation.setContinuousCollision(continuous);
+
+    // Headless mode: simulate a fixed number of steps as fast as possible and report the throughput.
+    if (headless) {
+        headlessSettings.capture.width = static_cast<unsigned>(headlessSettings.worldSize.x);  // Video covers the world.
+        headlessSettings.capture.height = static_cast<unsigned>(headlessSettings.worldSize.y);
+        headlessSettings.bakeDebris = bakeDebris;
+        headlessSettings.checkpointPath = checkpointPath;
+        headlessSettings.checkpointEvery = checkpointEvery;
+        HeadlessReport report;
+        if (!runHeadless(simulation, headlessSettings, report)) {
+            std::cerr << "Error: Failed to start headless recording!" << std::endl;
+            return -1;
+        }
+        std::cout << report.steps << " steps in " << report.seconds << " s ("
+                  << report.stepsPerSecond << " steps/s, " << report.framesRecorded << " frames recorded, "
+                  << report.checkpoints << " checkpoints)" << std::endl;
+        if (report.bytesLogged > 0) {
+            std::cout << "State log: " << report.bytesLogged << " bytes, render it with Engn_replay" << std::endl;
+        }
+        return writeTrace(tracePath);
+    }
+
+    // Create an SFML RenderWindow titled "Physics Engine": 800x600 pixels, or the world size of the restored snapshot.
+    const sf::VideoMode videoMode = restorePath.empty()
+        ? sf::VideoMode(800, 600)
+        : sf::VideoMode(static_cast<unsigned>(restored.worldSize.x), static_cast<unsigned>(restored.worldSize.y));
+    sf::RenderWindow window(videoMode, "Physics Engine", sf::Style::Default);
+    simulation.setWorldSize(sf::Vector2f(window.getSize()));  // The world spans the whole window.
+    if (bakeDebris && !Object::staticObjects.enableBaking(window.getSize())) {
+        std::cerr << "Warning: Failed to create the debris texture, drawing debris directly." << std::endl;
+    }
 
-    // Store all objects in a vector for easier management.
-    std::vector<Object*> objects = {&circle, &square, &triangle};
+    // Batched renderer drawing every visible body with one draw call.
+    BodyRenderer bodyRenderer;
+
+    // Physics advances by a fixed step whatever the frame rate; frames are drawn between two steps.
+    if (timestepSettings.step <= 0.0f || timestepSettings.maxStepsPerFrame == 0) {
+        std::cerr << "Error: --step and --max-steps must be positive!" << std::endl;
+        return -1;
+    }
+    StepScheduler scheduler(timestepSettings);
+
+    // Periodic snapshots of the scene, copied on this thread and written on a background one.
+    std::unique_ptr<Checkpointer> checkpointer;
+    if (!checkpointPath.empty()) {
+        checkpointer = std::make_unique<Checkpointer>(checkpointPath);
+    }
+    std::uint64_t stepCount = restored.step;  // Physics steps simulated, counting those before the restore.
+    auto checkpointInfo = [&]() {
+        SnapshotInfo info;
+        info.step = stepCount;
+        info.time = static_cast<double>(stepCount) * timestepSettings.step;
+        info.worldSize = simulation.getWorldSize();
+        return info;
+    };
 
     // Create an SFML clock to measure time between frames.
     sf::Clock clock;
 
-    // Initialize OpenCV VideoWriter to record the simulation as a video file.
-    cv::VideoWriter videoWriter;
-    int frameWidth = window.getSize().x;  // Get window width.
-    int frameHeight = window.getSize().y;  // Get window height.
-    videoWriter.open("output.avi", cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), 30, cv::Size(frameWidth, frameHeight), true);
-    if (!videoWriter.isOpened()) {  // Check if the video file was successfully opened.
+    // Start the asynchronous video capture: frames are encoded on a background thread. With `--record log`,
+    // only the body states are logged and the video is rendered offline by `Engn_replay`.
+    const bool logStates = headlessSettings.raster == HeadlessRaster::StateLog;
+    StateRecorder recorder(headlessSettings.stateLog);
+    CaptureSettings captureSettings;
+    captureSettings.path = "output.avi";
+    captureSettings.width = window.getSize().x;   // Get window width.
+    captureSettings.height = window.getSize().y;  // Get window height.
+    captureSettings.fps = 30.0;                    // Video frame rate, independent of the render rate.
+    captureSettings.policy = CapturePolicy::Block; // Record every frame even if the encoder falls behind.
+    FrameCapture capture(captureSettings);
+    if (logStates) {
+        if (!recorder.open(sf::Vector2f(window.getSize()), Object::staticObjects.capacity())) {
+            return -1;  // The reason was printed by `open`.
+        }
+    } else if (!capture.open()) {  // Check if the video file was successfully opened.
         std::cerr << "Error: Failed to open file for video recording!" << std::endl;
         return -1;  // Exit the program with an error code.
     }
 
+#ifdef ENGN_PROFILING
+    // On-screen panel with the rolling p50/p99 of every stage, toggled with F3.
+    ProfilerOverlay profilerOverlay;
+    if (!profilerOverlay.loadFont(fontPath)) {
+        std::cerr << "Warning: Failed to load " << fontPath << ", the profiler panel shows bars only." << std::endl;
+    }
+    if (!showProfiler) profilerOverlay.toggle();
+#endif
+
     // Main game loop.
     while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {  // Poll for events like closing the window or resizing it.
-            if (event.type == sf::Event::Closed)
-                window.close();  // Close the window if the close event is triggered.
-
-            if (event.type == sf::Event::Resized) {
-                // Update the visible area of the window when resized.
-                sf::FloatRect visibleArea(0, 0, event.size.width, event.size.height);
-                window.setView(sf::View(visibleArea));
-
-                // Adjust object positions to handle boundary collisions after resizing.
-                for (auto obj : objects) {
-                    obj->handleBoundaryCollision(window);  // Check and handle collisions with window boundaries.
+        ENGN_PROFILE_FRAME();  // Collect the samples of the previous frame from every thread.
+        ENGN_PROFILE_SCOPE("frame");
+
+        {
+            ENGN_PROFILE_SCOPE("events");
+            sf::Event event;
+            while (window.pollEvent(event)) {  // Poll for events like closing the window or resizing it.
+                if (event.type == sf::Event::Closed)
+                    window.close();  // Close the window if the close event is triggered.
+
+#ifdef ENGN_PROFILING
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3)
+                    profilerOverlay.toggle();  // Show or hide the profiler panel.
+#endif
+
+                if (event.type == sf::Event::Resized) {
+                    // Update the visible area of the window when resized.
+                    sf::FloatRect visibleArea(0, 0, event.size.width, event.size.height);
+                    window.setView(sf::View(visibleArea));
+                    if (!logStates) {
+                        simulation.setWorldSize(sf::Vector2f(window.getSize()));  // The world follows the window.
+                    }  // A state log keeps the world size of its header: the replayed video cannot change size.
+                    if (Object::staticObjects.isBaking()) {
+                        Object::staticObjects.enableBaking(window.getSize());  // Grow the debris texture with the window.
+                    }
+
+                    // Adjust body positions to handle boundary collisions after resizing. Every body of the store,
+                    // since restored bodies have no `Object` in the simulation's list.
+                    for (std::size_t id = 0; id < Object::bodies.size(); ++id) {
+                        Object::handleBoundaryCollision(id, simulation.getWorldSize());
+                    }
                 }
             }
         }
@@ -62,58 +311,56 @@ int main() {
         // Calculate the time elapsed since the last frame (delta time).
         float deltaTime = clock.restart().asSeconds();
 
-        // Clear the window and update/draw all objects.
-        window.clear();
-        for (auto obj : objects) {
-            obj->update(deltaTime);  // Update the object's state based on physics and delta time.
-            obj->handleBoundaryCollision(window);  // Handle boundary collisions for each object.
+        // Run the fixed physics steps this frame covers: integration, boundaries, broadphase and collision resolution.
+        const unsigned steps = scheduler.advance(simulation, deltaTime);
+        ENGN_PROFILE_COUNTER("debris", Object::staticObjects.size());
+
+        // Checkpoint whenever the step count crosses a multiple of `checkpointEvery`.
+        const std::uint64_t previousCount = stepCount;
+        stepCount += steps;
+        if (checkpointer && checkpointEvery > 0 && stepCount / checkpointEvery != previousCount / checkpointEvery) {
+            checkpointer->save(checkpointInfo());  // Skipped if the previous checkpoint is still being written.
         }
 
-        // Sort objects by their horizontal position to optimize collision detection.
-        std::sort(objects.begin(), objects.end(), [](const Object* a, const Object* b) {
-            return a->getBounds().left < b->getBounds().left;
-        });
-
-        // Perform collision detection and resolution for nearby objects only.
-        for (size_t i = 0; i < objects.size(); ++i) {
-            for (size_t j = i + 1; j < objects.size(); ++j) {
-                // If the objects are too far apart horizontally, skip further checks.
-                if (objects[j]->getBounds().left > objects[i]->getBounds().left + objects[i]->getBounds().width) {
-                    break;
-                }
-                // Check for collisions and resolve them if detected.
-                if (Object::checkCollision(*objects[i], *objects[j])) {
-                    Object::resolveCollision(*objects[i], *objects[j]);
-                }
-            }
+        if (logStates) {
+            // Advance the log clock by the simulated time, not the frame time: the log samples physics states,
+            // and the scheduler may run fewer steps than the frame covers (or drop time after a long frame).
+            recorder.update(steps * timestepSettings.step, Object::bodies, Object::staticObjects);  // Before drawing bakes the new debris.
         }
 
-        // Draw all dynamic objects.
-        for (auto obj : objects) {
-            obj->draw(window);
+        {
+            ENGN_PROFILE_SCOPE("draw");
+            // Clear the window and draw all dynamic objects with a single draw call.
+            window.clear();
+            bodyRenderer.draw(Object::bodies, window, scheduler.getInterpolation());
+
+            // Draw all static objects stored in the staticObjects pool with a single draw call.
+            Object::staticObjects.draw(window);
         }
 
-        // Draw all static objects stored in the staticObjects list.
-        for (auto staticObj : Object::staticObjects) {
-            window.draw(*staticObj);
+        // Capture the frame for the video if one is due, before it is presented.
+        if (!logStates && capture.advance(deltaTime)) {
+            ENGN_PROFILE_SCOPE("capture");
+            capture.capture(window);
         }
 
+#ifdef ENGN_PROFILING
+        profilerOverlay.draw(window, Profiler::instance());  // Drawn after the capture so it stays out of the video.
+#endif
+
         // Display the updated frame on the screen.
+        ENGN_PROFILE_SCOPE("display");
         window.display();
-
-        // Capture the current frame as an image for video recording.
-        sf::Texture texture;
-        texture.create(window.getSize().x, window.getSize().y);  // Create a texture matching the window size.
-        texture.update(window);  // Update the texture with the current window contents.
-
-        // Convert the texture to an SFML image and then to an OpenCV Mat for video writing.
-        sf::Image screenshot = texture.copyToImage();
-        cv::Mat frame(frameHeight, frameWidth, CV_8UC4, const_cast<uint8_t*>(screenshot.getPixelsPtr()));
-        cv::cvtColor(frame, frame, cv::COLOR_RGBA2BGR);  // Convert from RGBA to BGR format for OpenCV compatibility.
-        videoWriter.write(frame);  // Write the frame to the video file.
     }
 
-    // Release the video writer resources and exit the program.
-    videoWriter.release();
-    return 0;
-}
\ No newline at end of file
+    // Flush the pending frames and release the video writer resources, then exit the program.
+    capture.close();
+    recorder.close();
+    if (checkpointer) {
+        checkpointer->wait();  // Let a running checkpoint finish, then save the final state.
+        checkpointer->save(checkpointInfo());
+        checkpointer->wait();
+    }
+    ENGN_PROFILE_FRAME();  // Collect the last frame and the encoder's backlog.
+    return writeTrace(tracePath);
+}
@@ -0,0 +1,161 @@
+#include "AviWriter.h"  // Include the header file for the AviWriter class.
+#include <cmath>        // Include `std::lround`.
+#include <iostream>     // Include `std::cerr` for error reporting.
+
+namespace {
+
+constexpr std::uint32_t AVIF_HASINDEX = 0x10;     // The file ends with an `idx1` index.
+constexpr std::uint32_t AVIIF_KEYFRAME = 0x10;    // Every MJPEG frame decodes on its own.
+constexpr std::uint64_t RIFF_LIMIT = 0xFFFFFFF0;  // Largest size a 32-bit RIFF field can hold, with some margin.
+
+// Positions of the fields filled in by `close`.
+constexpr std::size_t RIFF_SIZE_AT = 4;
+constexpr std::size_t TOTAL_FRAMES_AT = 48;   // `avih.dwTotalFrames`.
+constexpr std::size_t LENGTH_AT = 140;        // `strh.dwLength`.
+constexpr std::size_t MOVI_SIZE_AT = 216;     // Size of the `movi` list.
+
+// Little-endian fields of the RIFF headers.
+void putFourcc(std::vector<unsigned char>& out, const char* code) {
+    out.insert(out.end(), code, code + 4);
+}
+void putU16(std::vector<unsigned char>& out, std::uint16_t value) {
+    out.push_back(static_cast<unsigned char>(value));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+}
+void putU32(std::vector<unsigned char>& out, std::uint32_t value) {
+    putU16(out, static_cast<std::uint16_t>(value));
+    putU16(out, static_cast<std::uint16_t>(value >> 16));
+}
+
+// Overwrite a 32-bit field at `position`.
+void patchU32(std::ofstream& file, std::uint64_t position, std::uint32_t value) {
+    std::vector<unsigned char> bytes;
+    putU32(bytes, value);
+    file.seekp(static_cast<std::streamoff>(position));
+    file.write(reinterpret_cast<const char*>(bytes.data()), 4);
+}
+
+}  // namespace
+
+// Write the RIFF, `hdrl` and `movi` headers; sizes and counts are placeholders until `close`.
+bool AviWriter::open(const std::string& path, unsigned width, unsigned height, double fps) {
+    this->path = path;
+    index.clear();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Error: Cannot write " << path << std::endl;
+        return false;
+    }
+
+    std::vector<unsigned char> header;
+    putFourcc(header, "RIFF");
+    putU32(header, 0);                                                 // RIFF size (patched).
+    putFourcc(header, "AVI ");
+    putFourcc(header, "LIST");
+    putU32(header, 192);                                               // Size of the `hdrl` list.
+    putFourcc(header, "hdrl");
+
+    putFourcc(header, "avih");                                         // Main header.
+    putU32(header, 56);
+    putU32(header, static_cast<std::uint32_t>(std::lround(1000000.0 / fps)));  // Microseconds per frame.
+    putU32(header, 0);                                                 // Maximum bytes per second.
+    putU32(header, 0);                                                 // Padding granularity.
+    putU32(header, AVIF_HASINDEX);
+    putU32(header, 0);                                                 // Total frames (patched).
+    putU32(header, 0);                                                 // Initial frames.
+    putU32(header, 1);                                                 // Streams.
+    putU32(header, 0);                                                 // Suggested buffer size.
+    putU32(header, width);
+    putU32(header, height);
+    for (int i = 0; i < 4; ++i) putU32(header, 0);                     // Reserved.
+
+    putFourcc(header, "LIST");
+    putU32(header, 116);                                               // Size of the `strl` list.
+    putFourcc(header, "strl");
+    putFourcc(header, "strh");                                         // Stream header.
+    putU32(header, 56);
+    putFourcc(header, "vids");
+    putFourcc(header, "MJPG");
+    putU32(header, 0);                                                 // Flags.
+    putU16(header, 0);                                                 // Priority.
+    putU16(header, 0);                                                 // Language.
+    putU32(header, 0);                                                 // Initial frames.
+    putU32(header, 1000);                                              // Scale: rate / scale = frames per second.
+    putU32(header, static_cast<std::uint32_t>(std::lround(fps * 1000.0)));  // Rate.
+    putU32(header, 0);                                                 // Start.
+    putU32(header, 0);                                                 // Length in frames (patched).
+    putU32(header, 0);                                                 // Suggested buffer size.
+    putU32(header, 0xFFFFFFFF);                                        // Quality (default).
+    putU32(header, 0);                                                 // Sample size (varies per frame).
+    putU16(header, 0);                                                 // Frame rectangle.
+    putU16(header, 0);
+    putU16(header, static_cast<std::uint16_t>(width));
+    putU16(header, static_cast<std::uint16_t>(height));
+    putFourcc(header, "strf");                                         // Stream format: a `BITMAPINFOHEADER`.
+    putU32(header, 40);
+    putU32(header, 40);
+    putU32(header, width);
+    putU32(header, height);
+    putU16(header, 1);                                                 // Planes.
+    putU16(header, 24);                                                // Bits per pixel once decoded.
+    putFourcc(header, "MJPG");
+    putU32(header, width * height * 3);                                // Decoded image size.
+    for (int i = 0; i < 4; ++i) putU32(header, 0);                     // Resolution and palette.
+
+    putFourcc(header, "LIST");
+    putU32(header, 0);                                                 // Size of the `movi` list (patched).
+    moviStart = header.size();
+    putFourcc(header, "movi");
+
+    file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    return static_cast<bool>(file);
+}
+
+// Append a `00dc` chunk holding the JPEG, padded to an even size.
+bool AviWriter::write(const unsigned char* jpeg, std::size_t size) {
+    const std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+    const std::uint64_t indexSize = 16 * (index.size() + 1) + 8;
+    if (position + 8 + size + 1 + indexSize > RIFF_LIMIT) {
+        std::cerr << "Error: " << path << " would exceed the 4 GB limit of AVI files" << std::endl;
+        return false;
+    }
+
+    std::vector<unsigned char> chunk;
+    putFourcc(chunk, "00dc");
+    putU32(chunk, static_cast<std::uint32_t>(size));
+    file.write(reinterpret_cast<const char*>(chunk.data()), 8);
+    file.write(reinterpret_cast<const char*>(jpeg), static_cast<std::streamsize>(size));
+    if (size % 2 != 0) file.put('\0');
+
+    index.push_back({static_cast<std::uint32_t>(position - moviStart), static_cast<std::uint32_t>(size)});
+    return static_cast<bool>(file);
+}
+
+// Write `idx1` and the final sizes.
+bool AviWriter::close() {
+    if (!file.is_open()) return false;
+
+    const std::uint64_t moviEnd = static_cast<std::uint64_t>(file.tellp());
+    std::vector<unsigned char> entries;
+    putFourcc(entries, "idx1");
+    putU32(entries, static_cast<std::uint32_t>(16 * index.size()));
+    for (const IndexEntry& entry : index) {
+        putFourcc(entries, "00dc");
+        putU32(entries, AVIIF_KEYFRAME);
+        putU32(entries, entry.offset);
+        putU32(entries, entry.size);
+    }
+    file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size()));
+    const std::uint64_t fileEnd = static_cast<std::uint64_t>(file.tellp());
+
+    patchU32(file, RIFF_SIZE_AT, static_cast<std::uint32_t>(fileEnd - 8));
+    patchU32(file, TOTAL_FRAMES_AT, getFrameCount());
+    patchU32(file, LENGTH_AT, getFrameCount());
+    patchU32(file, MOVI_SIZE_AT, static_cast<std::uint32_t>(moviEnd - moviStart));
+    const bool ok = static_cast<bool>(file);
+    file.close();
+    if (!ok) {
+        std::cerr << "Error: Failed to finish " << path << std::endl;
+    }
+    return ok;
+}
@@ -0,0 +1,40 @@
+#ifndef AVI_WRITER_H  // Include guard to prevent multiple inclusions of this header file.
+#define AVI_WRITER_H  // Define the macro `AVI_WRITER_H` to ensure the file is included only once.
+
+#include <cstddef>   // Include `std::size_t`.
+#include <cstdint>   // Include fixed-width integer types for the RIFF fields.
+#include <fstream>   // Include file streams for the video file.
+#include <string>    // Include STL string for the output path.
+#include <vector>    // Include STL vector for the frame index.
+
+// Minimal MJPEG AVI muxer.
+// `cv::VideoWriter` only accepts raw images, so segments encoded in parallel could only be joined by decoding
+// and encoding them again. MJPEG frames are independent JPEG images, so here the already encoded frames are
+// copied into one AVI file as they are. The file follows AVI 1.0 (RIFF sizes are 32-bit, so up to 4 GB).
+class AviWriter {
+public:
+    // Create the file and write the headers. Returns false if the file cannot be opened.
+    bool open(const std::string& path, unsigned width, unsigned height, double fps);
+
+    // Append one JPEG-encoded frame. Returns false if it cannot be written or the file would exceed 4 GB.
+    bool write(const unsigned char* jpeg, std::size_t size);
+
+    // Write the frame index and fill in the sizes and frame count of the headers.
+    bool close();
+
+    std::uint32_t getFrameCount() const { return static_cast<std::uint32_t>(index.size()); }
+
+private:
+    // Position of a frame in the `movi` list.
+    struct IndexEntry {
+        std::uint32_t offset;  // From the `movi` identifier to the frame chunk.
+        std::uint32_t size;    // JPEG bytes, without the chunk header and padding.
+    };
+
+    std::string path;
+    std::ofstream file;
+    std::uint64_t moviStart = 0;     // File position of the `movi` identifier.
+    std::vector<IndexEntry> index;   // Frames written so far.
+};
+
+#endif // AVI_WRITER_H  // End of the include guard.
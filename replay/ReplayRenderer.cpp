@@ -0,0 +1,254 @@
+#include "ReplayRenderer.h"                  // Include the header file for the offline renderer.
+#include "AviWriter.h"                       // Include the MJPEG AVI muxer joining the segments.
+#include "../src/statelog/StateLog.h"        // Include the state log reader.
+#include "../src/render/CpuFramebuffer.h"    // Include the software rasterizer.
+#include "../src/render/BodyRenderer.h"      // Include the batched body geometry.
+#include <opencv2/opencv.hpp>                // Include OpenCV for the color conversion and JPEG encoding.
+#include <algorithm>                         // Include `std::max`.
+#include <chrono>                            // Include the steady clock used to time the render.
+#include <cmath>                             // Include `std::lround`.
+#include <condition_variable>                // Include the condition variables of the chunk queue.
+#include <cstdio>                            // Include `std::remove` for the segment files.
+#include <deque>                             // Include STL deque for the chunk queue.
+#include <fstream>                           // Include file streams for the segment files.
+#include <iostream>                          // Include `std::cerr` for error reporting.
+#include <memory>                            // Include `std::unique_ptr` for the segments.
+#include <mutex>                             // Include the mutex of the chunk queue.
+#include <thread>                            // Include STL thread for the rendering threads.
+#include <vector>                            // Include STL vector for the frame sizes.
+
+namespace {
+
+// Encoded frames of a chunk, stored in a segment file until they are joined.
+struct Segment {
+    std::string path;                    // Segment file.
+    std::vector<std::uint32_t> sizes;    // JPEG bytes of each frame, in order.
+    std::vector<unsigned> repeats;       // Video frames each log frame covers.
+    bool ok = true;                      // Whether every frame was rendered and written.
+};
+
+// A run of log frames and the state it starts from.
+struct Chunk {
+    std::uint64_t offset = 0;            // Log offset of the first frame.
+    std::size_t frameCount = 0;          // Log frames in the chunk.
+    ReplayState state;                   // Bodies before the first frame.
+    std::vector<Debris> debris;          // Live debris before the first frame, oldest first.
+    std::uint64_t debrisAdded = 0;       // Counters of the debris pool before the first frame.
+    std::uint64_t debrisEvicted = 0;
+    Segment* segment = nullptr;          // Where the rendered frames go.
+};
+
+// Chunks handed from the decoding pass to the rendering threads. Bounded, so only a few chunk states
+// are held in memory however long the log is.
+class ChunkQueue {
+public:
+    explicit ChunkQueue(std::size_t capacity) : capacity(capacity) {}
+
+    void push(Chunk&& chunk) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return chunks.size() < capacity; });
+        chunks.push_back(std::move(chunk));
+        notEmpty.notify_one();
+    }
+
+    // Take the next chunk; returns false once the queue is closed and empty.
+    bool pop(Chunk& chunk) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return !chunks.empty() || closed; });
+        if (chunks.empty()) return false;
+        chunk = std::move(chunks.front());
+        chunks.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    std::size_t capacity;
+    std::deque<Chunk> chunks;
+    bool closed = false;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+};
+
+// Rasterize and encode the frames of a chunk into its segment file.
+void renderChunk(const ReplaySettings& settings, const StateLogHeader& header, StateLogReader& reader, Chunk& chunk,
+                 unsigned width, unsigned height) {
+    Segment& segment = *chunk.segment;
+    std::ofstream out(segment.path, std::ios::binary | std::ios::trunc);
+    if (!out || !reader.seek(chunk.offset)) {
+        std::cerr << "Error: Cannot write " << segment.path << std::endl;
+        segment.ok = false;
+        return;
+    }
+
+    DebrisPool debris(static_cast<std::size_t>(header.debrisCapacity));  // Evicts exactly as the recorded run did.
+    debris.restore(chunk.debris, chunk.debrisAdded, chunk.debrisEvicted);
+    CpuFramebuffer framebuffer(width, height);
+    BodyRenderer bodyRenderer;
+    const sf::FloatRect worldArea(0.0f, 0.0f, header.worldSize.x, header.worldSize.y);
+    const std::vector<int> params{cv::IMWRITE_JPEG_QUALITY, settings.quality};
+    cv::Mat bgr;
+    std::vector<unsigned char> jpeg;
+
+    ReplayState& state = chunk.state;
+    for (std::size_t frame = 0; frame < chunk.frameCount; ++frame) {
+        if (!reader.next(state)) {
+            segment.ok = false;
+            return;
+        }
+        for (const Debris& piece : state.newDebris) {
+            debris.add(piece);
+        }
+
+        // Same layers as the headless CPU recording: bodies, then the semi-transparent debris over them.
+        framebuffer.clear();
+        bodyRenderer.build(state.bodies, worldArea, settings.scale);
+        framebuffer.fillTriangles(bodyRenderer.getVertices(), settings.scale);
+        const DebrisVertices pieces = debris.getVertices();
+        framebuffer.fillTriangles(pieces.data, pieces.count, settings.scale);
+
+        cv::Mat rgba(static_cast<int>(height), static_cast<int>(width), CV_8UC4,
+                     const_cast<std::uint8_t*>(framebuffer.getPixels()));
+        cv::cvtColor(rgba, bgr, cv::COLOR_RGBA2BGR);
+        if (!cv::imencode(".jpg", bgr, jpeg, params)) {
+            std::cerr << "Error: Failed to encode a frame" << std::endl;
+            segment.ok = false;
+            return;
+        }
+        out.write(reinterpret_cast<const char*>(jpeg.data()), static_cast<std::streamsize>(jpeg.size()));
+        segment.sizes.push_back(static_cast<std::uint32_t>(jpeg.size()));
+        segment.repeats.push_back(std::max(1u, state.repeat));
+    }
+    if (!out) {
+        std::cerr << "Error: Failed to write " << segment.path << std::endl;
+        segment.ok = false;
+    }
+}
+
+// Copy the frames of every segment, in order, into the video.
+bool joinSegments(const std::vector<std::unique_ptr<Segment>>& segments, AviWriter& video) {
+    std::vector<unsigned char> jpeg;
+    for (const auto& segment : segments) {
+        std::ifstream in(segment->path, std::ios::binary);
+        for (std::size_t frame = 0; frame < segment->sizes.size(); ++frame) {
+            jpeg.resize(segment->sizes[frame]);
+            in.read(reinterpret_cast<char*>(jpeg.data()), static_cast<std::streamsize>(jpeg.size()));
+            if (!in) {
+                std::cerr << "Error: Failed to read " << segment->path << std::endl;
+                return false;
+            }
+            for (unsigned r = 0; r < segment->repeats[frame]; ++r) {
+                if (!video.write(jpeg.data(), jpeg.size())) return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// Decode the log once, render its chunks in parallel, then join the segments.
+bool renderReplay(const ReplaySettings& settings, ReplayReport& report) {
+    const auto start = std::chrono::steady_clock::now();
+
+    if (settings.scale <= 0.0f || settings.chunkFrames == 0) {
+        std::cerr << "Error: The scale and the chunk size must be positive!" << std::endl;
+        return false;
+    }
+    StateLogReader reader;
+    if (!reader.open(settings.logPath)) {
+        return false;
+    }
+    const StateLogHeader header = reader.header();
+    const unsigned width = std::max(1L, std::lround(header.worldSize.x * settings.scale));
+    const unsigned height = std::max(1L, std::lround(header.worldSize.y * settings.scale));
+    const unsigned threadCount = settings.threads > 0 ? settings.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    // Rendering threads, each with its own reader positioned at the chunk it works on.
+    ChunkQueue queue(threadCount);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&] {
+            StateLogReader chunkReader;
+            const bool opened = chunkReader.open(settings.logPath);
+            Chunk chunk;
+            while (queue.pop(chunk)) {
+                if (opened) {
+                    renderChunk(settings, header, chunkReader, chunk, width, height);
+                } else {
+                    chunk.segment->ok = false;
+                }
+            }
+        });
+    }
+
+    // Decoding pass: follow the state through the log and cut it into chunks.
+    std::vector<std::unique_ptr<Segment>> segments;
+    auto dispatch = [&](Chunk&& chunk) {
+        segments.push_back(std::make_unique<Segment>());
+        segments.back()->path = settings.output + ".part" + std::to_string(segments.size() - 1);
+        chunk.segment = segments.back().get();
+        queue.push(std::move(chunk));
+    };
+
+    ReplayState state;
+    DebrisPool debris(static_cast<std::size_t>(header.debrisCapacity));
+    Chunk pending;
+    bool hasPending = false;
+    while (true) {
+        const bool startsChunk = report.logFrames % settings.chunkFrames == 0;
+        Chunk next;
+        if (startsChunk) {  // Keep the state before the frame: the chunk starts from it.
+            next.offset = reader.tell();
+            next.state = state;
+            debris.copyRecords(next.debris);
+            next.debrisAdded = debris.totalAdded();
+            next.debrisEvicted = debris.totalEvicted();
+        }
+        if (!reader.next(state)) break;
+        for (const Debris& piece : state.newDebris) {
+            debris.add(piece);
+        }
+
+        if (startsChunk) {
+            if (hasPending) dispatch(std::move(pending));
+            pending = std::move(next);
+            hasPending = true;
+        }
+        ++pending.frameCount;
+        ++report.logFrames;
+        report.videoFrames += std::max(1u, state.repeat);
+    }
+    if (hasPending) dispatch(std::move(pending));
+    queue.close();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Join the segments in order, without encoding anything again.
+    bool ok = true;
+    for (const auto& segment : segments) {
+        ok = ok && segment->ok;
+    }
+    if (ok) {
+        AviWriter video;
+        ok = video.open(settings.output, width, height, header.fps) && joinSegments(segments, video);
+        ok = video.close() && ok;
+    }
+    for (const auto& segment : segments) {
+        std::remove(segment->path.c_str());
+    }
+
+    report.chunks = segments.size();
+    report.width = width;
+    report.height = height;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return ok;
+}
@@ -0,0 +1,36 @@
+#ifndef REPLAY_RENDERER_H  // Include guard to prevent multiple inclusions of this header file.
+#define REPLAY_RENDERER_H  // Define the macro `REPLAY_RENDERER_H` to ensure the file is included only once.
+
+#include <cstddef>   // Include `std::size_t`.
+#include <cstdint>   // Include fixed-width integer types for statistics.
+#include <string>    // Include STL string for the paths.
+
+// Settings of an offline render.
+struct ReplaySettings {
+    std::string logPath;                 // State log written by `Engn --record log`.
+    std::string output = "replay.avi";   // MJPEG AVI video.
+    float scale = 1.0f;                  // Pixels per world unit: the video is the world size times this.
+    unsigned threads = 0;                // Rendering threads (0 = one per hardware thread).
+    std::size_t chunkFrames = 120;       // Log frames per chunk; each chunk is rendered by one thread.
+    int quality = 90;                    // JPEG quality, 0 to 100.
+};
+
+// Result of an offline render.
+struct ReplayReport {
+    std::uint64_t logFrames = 0;    // Frames read from the log.
+    std::uint64_t videoFrames = 0;  // Frames in the video (log frames plus repeats).
+    std::size_t chunks = 0;         // Chunks rendered.
+    unsigned width = 0;             // Video size in pixels.
+    unsigned height = 0;
+    double seconds = 0.0;           // Wall-clock duration.
+};
+
+// Render a state log into a video, in parallel.
+// One pass decodes the log, which is cheap, and hands each chunk of frames to a rendering thread together
+// with the state it starts from (the bodies and the live debris). Threads rasterize their chunk with
+// `CpuFramebuffer` and encode every frame to JPEG into a segment file of their own; the segments are then
+// joined in order into one AVI without encoding anything again. Returns false (and prints the reason) on
+// failure.
+bool renderReplay(const ReplaySettings& settings, ReplayReport& report);
+
+#endif // REPLAY_RENDERER_H  // End of the include guard.
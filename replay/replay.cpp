@@ -0,0 +1,43 @@
+#include "ReplayRenderer.h"  // Include the parallel offline renderer.
+#include <cstdlib>           // Include `std::atoi` / `std::atof` for command-line parsing.
+#include <iostream>          // Include console output.
+#include <string>            // Include STL string for command-line parsing.
+
+// Render a state log recorded with `Engn --record log` into an MJPEG AVI video.
+int main(int argc, char* argv[]) {
+    ReplaySettings settings;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--output" && hasValue) {
+            settings.output = argv[++i];  // Video file.
+        } else if (arg == "--scale" && hasValue) {
+            settings.scale = static_cast<float>(std::atof(argv[++i]));  // Pixels per world unit.
+        } else if (arg == "--threads" && hasValue) {
+            settings.threads = static_cast<unsigned>(std::atoi(argv[++i]));  // Rendering threads (0 = all cores).
+        } else if (arg == "--chunk" && hasValue) {
+            settings.chunkFrames = std::strtoull(argv[++i], nullptr, 10);  // Log frames per chunk.
+        } else if (arg == "--quality" && hasValue) {
+            settings.quality = std::atoi(argv[++i]);  // JPEG quality.
+        } else if (arg[0] != '-' && settings.logPath.empty()) {
+            settings.logPath = arg;  // State log to render.
+        } else {
+            settings.logPath.clear();
+            break;
+        }
+    }
+    if (settings.logPath.empty()) {
+        std::cerr << "Usage: " << argv[0] << " LOG [--output FILE] [--scale S] [--threads N] [--chunk N]"
+                  << " [--quality Q]" << std::endl;
+        return -1;
+    }
+
+    ReplayReport report;
+    if (!renderReplay(settings, report)) {
+        return -1;  // The reason was printed by `renderReplay`.
+    }
+    std::cout << report.videoFrames << " frames (" << report.width << "x" << report.height << ", "
+              << report.logFrames << " logged, " << report.chunks << " chunks) in " << report.seconds << " s -> "
+              << settings.output << std::endl;
+    return 0;
+}
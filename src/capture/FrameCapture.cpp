@@ -0,0 +1,189 @@
+#include "FrameCapture.h"    // Include the header file for the FrameCapture class.
+#include "../profile/Profiler.h"  // Include the stage instrumentation.
+#include <SFML/OpenGL.hpp>   // Include OpenGL for reading the framebuffer directly into pooled buffers.
+#include <algorithm>         // Include `std::min` and `std::fill`.
+#include <chrono>            // Include durations used for back-off while waiting.
+
+// Back-off used by the threads when a ring is empty or full.
+static void backOff() {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+}
+
+// Allocate the buffer pool up front; nothing is allocated per frame afterwards.
+FrameCapture::FrameCapture(const CaptureSettings& settings)
+    : settings(settings),
+      frames(std::max<std::size_t>(settings.poolSize, 2)),
+      freeSlots(frames.size()),
+      readySlots(frames.size()) {
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        frames[i].pixels.resize(static_cast<std::size_t>(settings.width) * settings.height * 4);
+        freeSlots.push(i);  // Every buffer starts out free.
+    }
+}
+
+FrameCapture::~FrameCapture() {
+    close();
+}
+
+// Open the video file and start the encoder thread.
+bool FrameCapture::open() {
+    writer.open(settings.path, settings.fourcc, settings.fps,
+                cv::Size(static_cast<int>(settings.width), static_cast<int>(settings.height)), true);
+    if (!writer.isOpened()) {
+        return false;  // The caller reports the error.
+    }
+    running = true;
+    encoder = std::thread(&FrameCapture::encodeLoop, this);
+    return true;
+}
+
+// Advance the capture clock; a frame is due every 1 / fps seconds of elapsed time.
+bool FrameCapture::advance(float deltaTime) {
+    const double period = 1.0 / settings.fps;
+    clockTime += deltaTime;
+    while (clockTime >= period) {
+        clockTime -= period;
+        ++owed;  // Several frames may be owed after a long frame; the captured image is repeated.
+    }
+    return owed > 0;
+}
+
+// Get a free buffer according to the policy.
+bool FrameCapture::acquireSlot(std::size_t& slot) {
+    switch (settings.policy) {
+        case CapturePolicy::Block:
+            while (!freeSlots.pop(slot)) {
+                backOff();  // Wait for the encoder to release a buffer.
+            }
+            return true;
+
+        case CapturePolicy::Decimate:
+            // With half the pool in flight, only capture every other due frame.
+            if (readySlots.size() * 2 >= frames.size()) {
+                skipNext = !skipNext;
+                if (skipNext) return false;
+            }
+            return freeSlots.pop(slot);
+
+        case CapturePolicy::Drop:
+        default:
+            return freeSlots.pop(slot);  // Skip the frame if no buffer is free.
+    }
+}
+
+// Get a free buffer and set its repeat count, or account for the skipped frame.
+FrameCapture::Frame* FrameCapture::acquire(std::size_t& slot) {
+    if (!running || owed == 0) return nullptr;
+
+    if (!acquireSlot(slot)) {
+        carried += owed;  // The previous image stays on screen for the skipped frames.
+        owed = 0;
+        ++dropped;
+        return nullptr;
+    }
+
+    Frame& frame = frames[slot];
+    frame.repeat = owed + carried;
+    owed = 0;
+    carried = 0;
+    return &frame;
+}
+
+// Read back the current contents of the target and queue it for encoding.
+void FrameCapture::capture(sf::RenderTarget& target) {
+    ENGN_PROFILE_SCOPE("readback");
+    std::size_t slot;
+    Frame* frame = acquire(slot);
+    if (!frame) return;
+
+    // Read the top-left part of the target that fits the video (the window may have been resized).
+    const sf::Vector2u size = target.getSize();
+    const unsigned w = std::min(size.x, settings.width);
+    const unsigned h = std::min(size.y, settings.height);
+    if (w != settings.width || h != settings.height) {
+        std::fill(frame->pixels.begin(), frame->pixels.end(), 0);  // Pad the uncovered area with black.
+    }
+
+    target.setActive(true);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ROW_LENGTH, static_cast<GLint>(settings.width));
+    // OpenGL rows start at the bottom: the top of the target is at y = size.y - h.
+    // Rows land in the buffer bottom-first, starting at video row (height - h) so the image stays top-aligned.
+    std::uint8_t* dest = frame->pixels.data() + static_cast<std::size_t>(settings.height - h) * settings.width * 4;
+    glReadPixels(0, static_cast<GLint>(size.y - h), static_cast<GLsizei>(w), static_cast<GLsizei>(h),
+                 GL_RGBA, GL_UNSIGNED_BYTE, dest);
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+
+    ++captured;
+    readySlots.push(slot);  // Cannot fail: there are as many ring slots as buffers.
+}
+
+// Copy an RGBA image from memory into a pooled buffer and queue it for encoding.
+void FrameCapture::capture(const std::uint8_t* pixels, unsigned width, unsigned height) {
+    ENGN_PROFILE_SCOPE("readback");
+    std::size_t slot;
+    Frame* frame = acquire(slot);
+    if (!frame) return;
+
+    const unsigned w = std::min(width, settings.width);
+    const unsigned h = std::min(height, settings.height);
+    if (w != settings.width || h != settings.height) {
+        std::fill(frame->pixels.begin(), frame->pixels.end(), 0);  // Pad the uncovered area with black.
+    }
+
+    // Pooled buffers are bottom row first (the encoder flips them), so copy the rows in reverse order.
+    const std::size_t rowBytes = static_cast<std::size_t>(w) * 4;
+    for (unsigned y = 0; y < h; ++y) {
+        const std::uint8_t* src = pixels + static_cast<std::size_t>(y) * width * 4;
+        std::uint8_t* dest = frame->pixels.data() + static_cast<std::size_t>(settings.height - 1 - y) * settings.width * 4;
+        std::copy(src, src + rowBytes, dest);
+    }
+
+    ++captured;
+    readySlots.push(slot);
+}
+
+// Body of the encoder thread: convert, flip and write queued frames until stopped and drained.
+void FrameCapture::encodeLoop() {
+    ENGN_PROFILE_THREAD("encoder");
+    const int w = static_cast<int>(settings.width);
+    const int h = static_cast<int>(settings.height);
+    cv::Mat bgr(h, w, CV_8UC3);      // Conversion target, allocated once.
+    cv::Mat upright(h, w, CV_8UC3);  // Flipped frame, allocated once.
+
+    std::size_t slot;
+    for (;;) {
+        if (!readySlots.pop(slot)) {
+            if (running.load(std::memory_order_acquire)) {
+                backOff();
+                continue;
+            }
+            // The last frames may have been queued between the failed pop and `close()`: once the stop is
+            // seen, everything pushed before it is visible, so keep popping until the ring is really empty.
+            if (!readySlots.pop(slot)) break;  // Stopped and drained.
+        }
+
+        ENGN_PROFILE_SCOPE("encode");  // Conversion and `VideoWriter::write` of one queued frame.
+        Frame& frame = frames[slot];
+        cv::Mat rgba(h, w, CV_8UC4, frame.pixels.data());  // Wraps the pooled buffer, no copy.
+        cv::cvtColor(rgba, bgr, cv::COLOR_RGBA2BGR);         // Convert from RGBA to BGR format for OpenCV compatibility.
+        cv::flip(bgr, upright, 0);                          // OpenGL rows are bottom-up.
+        for (unsigned i = 0; i < frame.repeat; ++i) {
+            writer.write(upright);  // Write the frame to the video file.
+            ++encoded;
+        }
+
+        freeSlots.push(slot);  // Return the buffer to the pool.
+    }
+}
+
+// Encode the remaining frames, stop the encoder thread and close the video file.
+void FrameCapture::close() {
+    if (encoder.joinable()) {
+        running.store(false, std::memory_order_release);  // The encoder drains the ring before exiting.
+        encoder.join();
+    }
+    if (writer.isOpened()) {
+        writer.release();
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef FRAME_CAPTURE_H  // Include guard to prevent multiple inclusions of this header file.
+#define FRAME_CAPTURE_H  // Define the macro `FRAME_CAPTURE_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>   // Include SFML graphics for the render targets that are captured.
+#include <opencv2/opencv.hpp>  // Include OpenCV for color conversion and video encoding.
+#include "SpscRing.h"          // Include the lock-free ring used to hand frames to the encoder.
+#include <atomic>              // Include atomics for the stop flag and statistics.
+#include <cstdint>             // Include fixed-width integer types for pixel data.
+#include <string>              // Include STL string for the output path.
+#include <thread>              // Include STL thread for the background encoder.
+#include <vector>              // Include STL vector for the frame buffers.
+
+// What to do when the encoder falls behind and the frame pool runs low.
+enum class CapturePolicy {
+    Block,     // Wait for the encoder to free a buffer (every frame is recorded, the loop may stall).
+    Drop,      // Skip frames while no buffer is free; the previous frame is held longer in the video.
+    Decimate   // Halve the capture rate as soon as half the pool is in flight, then drop if still full.
+};
+
+// Settings of a capture session.
+struct CaptureSettings {
+    std::string path = "output.avi";           // Output video file.
+    int fourcc = cv::VideoWriter::fourcc('M', 'J', 'P', 'G');  // Codec.
+    unsigned width = 800;                      // Video frame width in pixels.
+    unsigned height = 600;                     // Video frame height in pixels.
+    double fps = 30.0;                         // Video frame rate; frames are taken at this rate of elapsed time.
+    std::size_t poolSize = 8;                  // Number of preallocated frame buffers.
+    CapturePolicy policy = CapturePolicy::Block;  // Behavior when the encoder falls behind.
+};
+
+// Asynchronous video capture.
+// The render thread reads the frame back into one of a fixed pool of preallocated RGBA buffers and
+// hands it to a background encoder thread through a lock-free ring; the encoder converts it to BGR
+// and writes it with `cv::VideoWriter`. Frames are taken at the video frame rate of elapsed time, not
+// once per rendered frame, so the video plays back at real speed whatever the render rate is.
+class FrameCapture {
+public:
+    explicit FrameCapture(const CaptureSettings& settings);
+    ~FrameCapture();  // Flushes pending frames and stops the encoder.
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Open the video file and start the encoder thread. Returns false if the file cannot be opened.
+    bool open();
+
+    // Advance the capture clock by `deltaTime` seconds. Returns true if a frame is due now.
+    bool advance(float deltaTime);
+
+    // Read back the current contents of `target` (before `display()`) and queue it for encoding.
+    void capture(sf::RenderTarget& target);
+
+    // Queue an RGBA image from memory (rows top to bottom, `width` x `height`) for encoding.
+    void capture(const std::uint8_t* pixels, unsigned width, unsigned height);
+
+    // Encode the remaining frames, stop the encoder thread and close the video file.
+    void close();
+
+    // Statistics.
+    std::uint64_t framesCaptured() const { return captured.load(); }  // Frames read back and queued.
+    std::uint64_t framesDropped() const { return dropped.load(); }    // Captures skipped because of the policy.
+    std::uint64_t framesEncoded() const { return encoded.load(); }    // Video frames written (including repeats).
+
+private:
+    // A pooled frame buffer.
+    struct Frame {
+        std::vector<std::uint8_t> pixels;  // RGBA pixels, bottom row first (OpenGL order).
+        unsigned repeat = 1;               // Number of video frames this image covers.
+    };
+
+    // Get a free buffer according to the policy and set its repeat count.
+    // Returns nullptr if the frame must be skipped.
+    Frame* acquire(std::size_t& slot);
+
+    // Get a free buffer according to the policy; returns false if the frame must be skipped.
+    bool acquireSlot(std::size_t& slot);
+
+    // Body of the encoder thread.
+    void encodeLoop();
+
+    CaptureSettings settings;
+    cv::VideoWriter writer;
+    std::vector<Frame> frames;        // Buffer pool, allocated once.
+    SpscRing<std::size_t> freeSlots;  // Buffers available to the render thread (encoder -> render thread).
+    SpscRing<std::size_t> readySlots; // Buffers waiting to be encoded (render thread -> encoder).
+    std::thread encoder;
+    std::atomic<bool> running{false};
+
+    double clockTime = 0.0;     // Elapsed time accumulated since the last video frame.
+    unsigned owed = 0;          // Video frames due since the last capture.
+    unsigned carried = 0;       // Video frames from skipped captures, added to the next captured frame.
+    bool skipNext = false;      // Decimation toggle.
+
+    std::atomic<std::uint64_t> captured{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<std::uint64_t> encoded{0};
+};
+
+#endif // FRAME_CAPTURE_H  // End of the include guard.
@@ -0,0 +1,58 @@
+#ifndef SPSC_RING_H  // Include guard to prevent multiple inclusions of this header file.
+#define SPSC_RING_H  // Define the macro `SPSC_RING_H` to ensure the file is included only once.
+
+#include <atomic>   // Include atomics for the lock-free head and tail indices.
+#include <vector>   // Include STL vector for the fixed-size slot storage.
+#include <cstddef>  // Include `std::size_t`.
+
+// Bounded lock-free single-producer/single-consumer ring buffer.
+// Exactly one thread may call `push` and exactly one (other) thread may call `pop`.
+// The storage is allocated once in the constructor; no allocation happens afterwards.
+template <typename T>
+class SpscRing {
+public:
+    // Create a ring able to hold `capacity` elements.
+    explicit SpscRing(std::size_t capacity) : slots(capacity + 1) {}
+
+    // Try to append a value; returns false if the ring is full. Producer thread only.
+    bool push(const T& value) {
+        const std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+        const std::size_t next = increment(tail);
+        if (next == headIndex.load(std::memory_order_acquire)) {
+            return false;  // Full: the consumer has not freed the slot yet.
+        }
+        slots[tail] = value;
+        tailIndex.store(next, std::memory_order_release);  // Publish the value to the consumer.
+        return true;
+    }
+
+    // Try to remove the oldest value; returns false if the ring is empty. Consumer thread only.
+    bool pop(T& value) {
+        const std::size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) {
+            return false;  // Empty: nothing has been published yet.
+        }
+        value = slots[head];
+        headIndex.store(increment(head), std::memory_order_release);  // Hand the slot back to the producer.
+        return true;
+    }
+
+    // Approximate number of queued elements (exact when called from either end while the other is idle).
+    std::size_t size() const {
+        const std::size_t head = headIndex.load(std::memory_order_acquire);
+        const std::size_t tail = tailIndex.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : tail + slots.size() - head;
+    }
+
+    // Maximum number of elements the ring can hold.
+    std::size_t capacity() const { return slots.size() - 1; }
+
+private:
+    std::size_t increment(std::size_t index) const { return index + 1 == slots.size() ? 0 : index + 1; }
+
+    std::vector<T> slots;                      // Storage; one slot is always left empty to tell full from empty.
+    alignas(64) std::atomic<std::size_t> headIndex{0};  // Next slot to pop (written by the consumer).
+    alignas(64) std::atomic<std::size_t> tailIndex{0};  // Next slot to push (written by the producer).
+};
+
+#endif // SPSC_RING_H  // End of the include guard.
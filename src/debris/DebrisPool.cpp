@@ -0,0 +1,179 @@
+#include "DebrisPool.h"                 // Include the header file for the DebrisPool class.
+#include "../render/ShapeGeometry.h"    // Include the helpers turning a shape into triangles.
+#include <algorithm>                    // Include `std::min`.
+
+// Allocate the ring once.
+DebrisPool::DebrisPool(std::size_t capacity)
+    : records(std::max<std::size_t>(capacity, 1)), vertexCounts(records.size(), 0) {}
+
+// Change the cap, keeping the newest records that fit.
+void DebrisPool::setCapacity(std::size_t capacity) {
+    capacity = std::max<std::size_t>(capacity, 1);
+    std::size_t keep = std::min(count, capacity);
+    std::vector<Debris> resized(capacity);
+    for (std::size_t i = 0; i < keep; ++i) {
+        resized[i] = (*this)[count - keep + i];  // Newest records, oldest first.
+    }
+    evicted += count - keep;
+    records.swap(resized);
+
+    // The baked records kept for snapshots follow the new cap too.
+    std::vector<Debris> newestBaked;
+    const std::size_t bakedKeep = std::min(baked.size(), capacity);
+    for (std::size_t i = baked.size() - bakedKeep; i < baked.size(); ++i) {
+        newestBaked.push_back(baked[(bakedHead + i) % baked.size()]);
+    }
+    baked.swap(newestBaked);
+    bakedHead = 0;
+
+    vertexCounts.assign(capacity, 0);
+    head = 0;
+    count = keep;
+    unbuilt = 0;
+    dirty = true;
+}
+
+// Store a new piece of debris, evicting the oldest one when the ring is full.
+void DebrisPool::add(const Debris& debris) {
+    if (count == records.size()) {
+        // Drop the oldest record's triangles by skipping them, or forget it if they were never built.
+        if (unbuilt < count) {
+            firstVertex += vertexCounts[head];
+        } else {
+            --unbuilt;
+        }
+        records[head] = debris;                  // Overwrite the oldest record...
+        head = (head + 1) % records.size();      // ...which makes the next one the oldest.
+        ++evicted;
+    } else {
+        records[(head + count) % records.size()] = debris;
+        ++count;
+    }
+    ++unbuilt;
+    ++added;
+}
+
+// Remove every live record.
+void DebrisPool::clear() {
+    head = 0;
+    count = 0;
+    unbuilt = 0;
+    dirty = true;
+}
+
+// Live record `i`, oldest first.
+const Debris& DebrisPool::operator[](std::size_t i) const {
+    return records[(head + i) % records.size()];
+}
+
+// Copy the newest baked records, then the live ones, in order.
+void DebrisPool::copyRecords(std::vector<Debris>& out) const {
+    const std::size_t bakedCount = std::min(baked.size(), records.size() - count);
+    out.resize(bakedCount + count);
+    for (std::size_t i = 0; i < bakedCount; ++i) {
+        out[i] = baked[(bakedHead + baked.size() - bakedCount + i) % baked.size()];
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        out[bakedCount + i] = (*this)[i];
+    }
+}
+
+// Replace the live records and the counters.
+void DebrisPool::restore(const std::vector<Debris>& live, std::uint64_t totalAdded, std::uint64_t totalEvicted) {
+    clear();
+    baked.clear();  // The restored records stand for all debris, baked or not.
+    bakedHead = 0;
+    for (const Debris& debris : live) {
+        add(debris);  // Evicts the oldest records if there are more than the cap.
+    }
+    added = totalAdded;
+    evicted = totalEvicted;
+}
+
+// Create (or resize) the accumulation texture.
+bool DebrisPool::enableBaking(sf::Vector2u size) {
+    if (accumulation && accumulation->getSize() == size) return true;
+
+    auto texture = std::make_unique<sf::RenderTexture>();
+    if (!texture->create(size.x, size.y)) {
+        return false;
+    }
+    texture->clear(sf::Color::Transparent);
+    if (accumulation) {
+        // Keep what was already baked: copy the old texture over unchanged.
+        accumulation->display();
+        sf::Sprite previous(accumulation->getTexture());
+        texture->draw(previous, sf::RenderStates(sf::BlendNone));
+    }
+    texture->display();
+    accumulation = std::move(texture);
+    return true;
+}
+
+// Stop baking; the baked pixels (and the baked records kept with them) are discarded.
+void DebrisPool::disableBaking() {
+    accumulation.reset();
+    baked.clear();
+    bakedHead = 0;
+}
+
+// Triangles of the live records: append the new records, rebuilding only after a reset or once the
+// evicted prefix is larger than the live part (so each record is built an amortized constant number of times).
+DebrisVertices DebrisPool::getVertices() {
+    if (dirty || firstVertex > vertices.getVertexCount() - firstVertex) {
+        vertices.clear();  // Keeps the allocated capacity.
+        firstVertex = 0;
+        unbuilt = count;
+        dirty = false;
+    }
+    for (std::size_t i = count - unbuilt; i < count; ++i) {
+        const Debris& d = (*this)[i];
+        const std::size_t start = vertices.getVertexCount();
+        appendShapeTriangles(vertices, d.kind, d.position, d.extent, d.color,
+                             circleSegments(0.5f * std::max(d.extent.x, d.extent.y)));
+        vertexCounts[(head + i) % records.size()] = static_cast<std::uint32_t>(vertices.getVertexCount() - start);
+    }
+    unbuilt = 0;
+
+    DebrisVertices live;
+    live.count = vertices.getVertexCount() - firstVertex;
+    live.data = live.count > 0 ? &vertices[firstVertex] : nullptr;
+    return live;
+}
+
+// Paint the live records into the accumulation texture with one draw call and release them.
+void DebrisPool::bake() {
+    if (count == 0) return;
+    const DebrisVertices live = getVertices();
+    accumulation->draw(live.data, live.count, sf::Triangles);
+    accumulation->display();
+    for (std::size_t i = 0; i < count; ++i) {
+        keepBaked((*this)[i]);
+    }
+    clear();
+}
+
+// Append a baked record, overwriting the oldest one once the cap is reached.
+void DebrisPool::keepBaked(const Debris& debris) {
+    if (baked.size() < records.size()) {
+        baked.push_back(debris);
+    } else {
+        baked[bakedHead] = debris;
+        bakedHead = (bakedHead + 1) % baked.size();
+    }
+}
+
+// Draw all debris with a single draw call.
+void DebrisPool::draw(sf::RenderTarget& target) {
+    if (accumulation) {
+        bake();
+        // The accumulated colors are already multiplied by their alpha, so composite them as premultiplied.
+        sf::Sprite sprite(accumulation->getTexture());
+        target.draw(sprite, sf::RenderStates(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha)));
+        return;
+    }
+    if (count > 0) {
+        const DebrisVertices live = getVertices();
+        target.draw(live.data, live.count, sf::Triangles);
+    }
+}
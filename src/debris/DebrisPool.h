@@ -0,0 +1,88 @@
+#ifndef DEBRIS_POOL_H  // Include guard to prevent multiple inclusions of this header file.
+#define DEBRIS_POOL_H  // Define the macro `DEBRIS_POOL_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>                // Include SFML graphics for colors, vertices and render textures.
+#include "../obj/abs/enum/ShapeKind.h"      // Include the `ShapeKind` enum.
+#include <cstdint>                          // Include fixed-width integer types for counters.
+#include <memory>                           // Include `std::unique_ptr` for the accumulation texture.
+#include <vector>                           // Include STL vector for the preallocated records.
+
+// One piece of immovable debris left behind by a collision: a plain value, no `sf::Shape` behind it.
+struct Debris {
+    ShapeKind kind = ShapeKind::Square;  // Shape of the debris.
+    sf::Vector2f position;               // Top-left corner of its bounding box.
+    sf::Vector2f extent;                 // Size of its bounding box.
+    sf::Color color;                     // Fill color (semi-transparent).
+};
+
+// Triangles of the live debris: `count` vertices from `data`, valid until the pool changes.
+struct DebrisVertices {
+    const sf::Vertex* data = nullptr;
+    std::size_t count = 0;
+};
+
+// Bounded store of debris.
+// Records live in a ring preallocated to `capacity` entries; once full, each new piece evicts the
+// oldest one, so memory stays constant however many collisions happen. All debris is drawn with one
+// draw call from a shared vertex array, which only gains the triangles of new pieces: evicted pieces leave
+// a stale prefix that is skipped, and compacted once it outweighs the live triangles. With baking enabled, debris is instead painted once into a
+// persistent accumulation texture and released, so drawing it costs one textured quad in total; the newest
+// baked records (up to the cap) are still kept aside so snapshots hold them.
+class DebrisPool {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 100000;  // Default number of live debris records.
+
+    explicit DebrisPool(std::size_t capacity = DEFAULT_CAPACITY);
+
+    void setCapacity(std::size_t capacity);       // Change the cap, keeping the newest records that fit.
+    std::size_t capacity() const { return records.size(); }
+
+    void add(const Debris& debris);               // Store a new piece, evicting the oldest one when full.
+    void clear();                                 // Remove every live record (baked pixels stay).
+
+    std::size_t size() const { return count; }                          // Live (not yet baked) records.
+    const Debris& operator[](std::size_t i) const;                       // Live record `i`, oldest first.
+    std::uint64_t totalAdded() const { return added; }                   // Debris created since the start.
+    std::uint64_t totalEvicted() const { return evicted; }               // Debris dropped because of the cap.
+
+    // Copy the records a snapshot holds into `out`, oldest first: the live ones, preceded while baking by the
+    // newest baked ones, `capacity()` records at most in total.
+    void copyRecords(std::vector<Debris>& out) const;
+    // Replace the live records (oldest first, the newest kept if they exceed the cap) and the counters,
+    // e.g. from a snapshot.
+    void restore(const std::vector<Debris>& live, std::uint64_t totalAdded, std::uint64_t totalEvicted);
+
+    // Bake debris into an accumulation texture of the given size (typically the world size).
+    // Calling it again with another size keeps what was already baked.
+    bool enableBaking(sf::Vector2u size);
+    void disableBaking();                        // Go back to drawing live records (baked pixels are discarded).
+    bool isBaking() const { return accumulation != nullptr; }
+
+    // Draw all debris with a single draw call (bakes pending records first when baking is enabled).
+    void draw(sf::RenderTarget& target);
+
+    // Triangles of the live records, oldest first (only the records added since the last call are built).
+    DebrisVertices getVertices();
+
+private:
+    void bake();  // Paint the live records into the accumulation texture and release them.
+    void keepBaked(const Debris& debris);  // Remember a baked record, dropping the oldest beyond the cap.
+
+    std::vector<Debris> records;   // Ring storage, allocated once per capacity.
+    std::vector<std::uint32_t> vertexCounts;  // Vertices of the record in each slot, once built.
+    std::size_t head = 0;          // Slot of the oldest record.
+    std::size_t count = 0;         // Number of live records.
+    std::uint64_t added = 0;       // Debris created since the start.
+    std::uint64_t evicted = 0;     // Debris dropped because of the cap.
+
+    sf::VertexArray vertices{sf::Triangles};  // Geometry of the live records, after `firstVertex`.
+    std::size_t firstVertex = 0;              // Start of the live geometry (before it: evicted records).
+    std::size_t unbuilt = 0;                  // Newest records whose triangles are not in `vertices` yet.
+    bool dirty = true;                        // Whether `vertices` must be rebuilt from scratch.
+
+    std::unique_ptr<sf::RenderTexture> accumulation;  // Baked debris (null when baking is disabled).
+    std::vector<Debris> baked;                        // Newest baked records, up to the cap (a ring once full).
+    std::size_t bakedHead = 0;                        // Slot of the oldest baked record once `baked` is full.
+};
+
+#endif // DEBRIS_POOL_H  // End of the include guard.
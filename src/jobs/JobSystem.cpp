@@ -0,0 +1,113 @@
+#include "JobSystem.h"  // Include the header file for the JobSystem class.
+#include "../profile/Profiler.h"  // Include the stage instrumentation.
+#include <algorithm>    // Include `std::min`.
+
+// Start the worker threads; the calling thread is the pool's first member.
+JobSystem::JobSystem(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+// Stop and join the workers.
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Take the newest task of a queue (owner side, best cache locality).
+bool JobSystem::popLocal(std::size_t index, Task& task) {
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    --queued;
+    return true;
+}
+
+// Take the oldest task of another queue, starting with the thief's neighbor.
+bool JobSystem::steal(std::size_t thief, Task& task) {
+    const std::size_t count = queues.size();
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        Queue& queue = *queues[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            --queued;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Execute a task and count it as done.
+void JobSystem::run(const Task& task) {
+    ENGN_PROFILE_SCOPE("job");  // CPU time of the chunk, on whichever thread ran it.
+    (*task.body)(task.begin, task.end);
+    pending.fetch_sub(1, std::memory_order_release);
+}
+
+// Body of a worker thread: run own tasks, then steal, then sleep until more work arrives.
+void JobSystem::workerLoop(std::size_t index) {
+    ENGN_PROFILE_THREAD("worker");
+    Task task;
+    for (;;) {
+        if (popLocal(index, task) || steal(index, task)) {
+            run(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return stopping.load() || queued.load() > 0; });
+        if (stopping) return;
+    }
+}
+
+// Split [0, count) into chunks, deal them round-robin to the queues and help until all are done.
+void JobSystem::parallelFor(std::size_t count, std::size_t grain,
+                            const std::function<void(std::size_t, std::size_t)>& body) {
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+
+    // Run small loops (or single-threaded pools) inline: queuing would cost more than it saves.
+    if (queues.size() == 1 || count <= grain) {
+        body(0, count);
+        return;
+    }
+
+    const std::size_t chunks = (count + grain - 1) / grain;
+    pending.store(chunks, std::memory_order_relaxed);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        Queue& queue = *queues[c % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back({&body, c * grain, std::min(count, (c + 1) * grain)});
+        ++queued;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);  // Pairs with the workers' wait to avoid lost wake-ups.
+    }
+    wakeUp.notify_all();
+
+    // The calling thread works through its own queue, then steals until every chunk is finished.
+    Task task;
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (popLocal(0, task) || steal(0, task)) {
+            run(task);
+        } else {
+            std::this_thread::yield();  // The last chunks are running on other threads.
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef JOB_SYSTEM_H  // Include guard to prevent multiple inclusions of this header file.
+#define JOB_SYSTEM_H  // Define the macro `JOB_SYSTEM_H` to ensure the file is included only once.
+
+#include <atomic>              // Include atomics for counters and the stop flag.
+#include <condition_variable>  // Include condition variables so idle workers sleep.
+#include <cstddef>             // Include `std::size_t`.
+#include <deque>               // Include STL deque for the per-worker task queues.
+#include <functional>          // Include `std::function` for the job body.
+#include <memory>              // Include `std::unique_ptr` for the queues.
+#include <mutex>               // Include mutexes protecting each queue.
+#include <thread>              // Include STL thread for the workers.
+#include <vector>              // Include STL vector for the workers and queues.
+
+// Work-stealing thread pool.
+// Every worker owns a task queue: it takes work from the back of its own queue and, when that runs
+// dry, steals from the front of the others'. The thread calling `parallelFor` takes part in the work
+// through its own queue, so a pool of N threads starts N - 1 workers.
+class JobSystem {
+public:
+    // Create a pool using `threadCount` threads in total (0 = one per hardware thread).
+    explicit JobSystem(unsigned threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Number of threads working on a `parallelFor`, including the calling thread.
+    unsigned getThreadCount() const { return static_cast<unsigned>(queues.size()); }
+
+    // Run `body(begin, end)` over [0, count) split into chunks of at most `grain` elements,
+    // and return when every chunk is done. Must not be called from inside a job or from two threads at once.
+    void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body);
+
+private:
+    // A chunk of a `parallelFor`.
+    struct Task {
+        const std::function<void(std::size_t, std::size_t)>* body;  // Loop body shared by all chunks.
+        std::size_t begin, end;                                      // Range of the chunk.
+    };
+
+    // Task queue owned by one thread.
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool popLocal(std::size_t index, Task& task);  // Take the newest task of a queue (owner side).
+    bool steal(std::size_t thief, Task& task);     // Take the oldest task of another queue.
+    void run(const Task& task);                    // Execute a task and count it as done.
+    void workerLoop(std::size_t index);            // Body of a worker thread.
+
+    std::vector<std::unique_ptr<Queue>> queues;  // Queue 0 belongs to the calling thread.
+    std::vector<std::thread> workers;            // Worker threads (queues 1..N-1).
+    std::atomic<std::size_t> queued{0};          // Tasks waiting in the queues.
+    std::atomic<std::size_t> pending{0};         // Tasks of the current `parallelFor` not finished yet.
+    std::atomic<bool> stopping{false};           // Set when the pool shuts down.
+    std::mutex sleepMutex;                       // Protects the wake-up of idle workers.
+    std::condition_variable wakeUp;              // Signaled when tasks are queued or the pool stops.
+};
+
+#endif // JOB_SYSTEM_H  // End of the include guard.
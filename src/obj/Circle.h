@@ -9,12 +9,9 @@ class Circle : public Object {
 
 public:
     // Constructor: Initializes a circle with a given radius, position, and color.
-    Circle(float radius, sf::Vector2f position, sf::Color color) {
-        // Create an SFML `CircleShape` object using a unique pointer for memory management.
-        sh = std::make_unique<sf::CircleShape>(radius);  // Set the radius of the circle.
-        sh->setPosition(position);  // Set the position of the circle on the screen.
-        sh->setFillColor(color);    // Set the fill color of the circle.
-    }
+    // Its bounds span the circle's diameter.
+    Circle(float radius, sf::Vector2f position, sf::Color color)
+        : Object(ShapeKind::Circle, position, color, ShapeTraits<ShapeKind::Circle>::extent(radius)) {}
 };
 
 #endif // CIRCLE_H  // End of the include guard.
\ No newline at end of file
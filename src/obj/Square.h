@@ -9,12 +9,9 @@ class Square : public Object {
 
 public:
     // Constructor: Initializes a square with a given size, position, and color.
-    Square(float size, sf::Vector2f position, sf::Color color) {
-        // Create an SFML `RectangleShape` object using a unique pointer for memory management.
-        sh = std::make_unique<sf::RectangleShape>(sf::Vector2f{size, size});  // Set the size of the square (width = height = size).
-        sh->setPosition(position);  // Set the position of the square on the screen.
-        sh->setFillColor(color);    // Set the fill color of the square.
-    }
+    // Its bounds are `size` x `size`.
+    Square(float size, sf::Vector2f position, sf::Color color)
+        : Object(ShapeKind::Square, position, color, ShapeTraits<ShapeKind::Square>::extent(size)) {}
 };
 
 #endif // SQUARE_H  // End of the include guard.
\ No newline at end of file
@@ -9,22 +9,9 @@ class Triangle : public Object {
 
 public:
     // Constructor: Initializes a triangle with a given size, position, and color.
-    Triangle(float size, sf::Vector2f position, sf::Color color) {
-        // Create an SFML `ConvexShape` object with 3 points (a triangle) using a unique pointer for memory management.
-        sh = std::make_unique<sf::ConvexShape>(3);  // Initialize the convex shape with 3 vertices.
-
-        // Cast the shape to `sf::ConvexShape` to access its specific methods.
-        auto& convex = static_cast<sf::ConvexShape&>(*sh);
-
-        // Define the three vertices of the triangle:
-        convex.setPoint(0, {0, 0});               // Top-left corner.
-        convex.setPoint(1, {size, 0});            // Top-right corner.
-        convex.setPoint(2, {size / 2, size});     // Bottom-center point.
-
-        // Set the position and color of the triangle.
-        sh->setPosition(position);  // Set the position of the triangle on the screen.
-        sh->setFillColor(color);    // Set the fill color of the triangle.
-    }
+    // The triangle's bounding box is `size` x `size`; its vertices are given by `ShapeTraits<ShapeKind::Triangle>`.
+    Triangle(float size, sf::Vector2f position, sf::Color color)
+        : Object(ShapeKind::Triangle, position, color, ShapeTraits<ShapeKind::Triangle>::extent(size)) {}
 };
 
 #endif // TRIANGLE_H  // End of the include guard.
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef SHAPE_TRAITS_H  // Include guard to prevent multiple inclusions of this header file.
+#define SHAPE_TRAITS_H  // Define the macro `SHAPE_TRAITS_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>   // Include SFML vectors for extents.
+#include "enum/ShapeKind.h"    // Include the `ShapeKind` enum naming the closed set of shapes.
+#include <cstddef>             // Include `std::size_t`.
+#include <type_traits>         // Include `std::integral_constant` for the shape tags.
+
+// Compile-time description of each shape of the closed set. Every body is stored as a `ShapeKind` plus the
+// extent of its bounding box; the traits turn the size a shape is constructed with into that extent and
+// give its outline, so code specialised on a shape sees constants instead of calls through `sf::Shape`.
+template <ShapeKind Kind>
+struct ShapeTraits;
+
+// Circle inscribed in its bounding box, constructed from its radius.
+template <>
+struct ShapeTraits<ShapeKind::Circle> {
+    static constexpr std::size_t pointCount = 0;  // Curved outline: tessellated on demand.
+    static sf::Vector2f extent(float radius) { return {2 * radius, 2 * radius}; }
+};
+
+// Square filling its bounding box, constructed from its side.
+template <>
+struct ShapeTraits<ShapeKind::Square> {
+    static constexpr std::size_t pointCount = 4;
+    static sf::Vector2f extent(float size) { return {size, size}; }
+
+    // Corner `i` of a box of size `extent`, clockwise from the top-left.
+    static sf::Vector2f point(std::size_t i, sf::Vector2f extent) {
+        return {i == 1 || i == 2 ? extent.x : 0.0f, i >= 2 ? extent.y : 0.0f};
+    }
+};
+
+// Triangle with its base on the top edge and its apex at the bottom-center, constructed from its size.
+template <>
+struct ShapeTraits<ShapeKind::Triangle> {
+    static constexpr std::size_t pointCount = 3;
+    static sf::Vector2f extent(float size) { return {size, size}; }
+
+    // Vertex `i` of the triangle: top-left, top-right, bottom-center.
+    static sf::Vector2f point(std::size_t i, sf::Vector2f extent) {
+        return i == 0 ? sf::Vector2f(0.0f, 0.0f) : i == 1 ? sf::Vector2f(extent.x, 0.0f)
+                                                          : sf::Vector2f(extent.x / 2, extent.y);
+    }
+};
+
+// Type standing for one shape of the set, so a generic lambda can be instantiated once per shape.
+template <ShapeKind Kind>
+using ShapeTag = std::integral_constant<ShapeKind, Kind>;
+
+// Call `visitor(ShapeTag<kind>{})`. The switch is the only runtime step: each branch calls a separate
+// instantiation of the visitor, in which the shape is a compile-time constant and its code is inlined.
+template <typename Visitor>
+inline decltype(auto) visitShape(ShapeKind kind, Visitor&& visitor) {
+    switch (kind) {
+        case ShapeKind::Square:
+            return visitor(ShapeTag<ShapeKind::Square>{});
+        case ShapeKind::Triangle:
+            return visitor(ShapeTag<ShapeKind::Triangle>{});
+        case ShapeKind::Circle:
+        default:
+            return visitor(ShapeTag<ShapeKind::Circle>{});
+    }
+}
+
+// Call `visitor(ShapeTag<first>{}, ShapeTag<second>{})`, for kernels specialised on a pair of shapes.
+template <typename Visitor>
+inline decltype(auto) visitShapePair(ShapeKind first, ShapeKind second, Visitor&& visitor) {
+    return visitShape(first, [&](auto a) {
+        return visitShape(second, [&](auto b) { return visitor(a, b); });
+    });
+}
+
+#endif // SHAPE_TRAITS_H  // End of the include guard.
@@ -0,0 +1,14 @@
+#ifndef SHAPE_KIND_H  // Include guard to prevent multiple inclusions of this header file.
+#define SHAPE_KIND_H  // Define the macro `SHAPE_KIND_H` to ensure the file is included only once.
+
+#include <cstdint>  // Include fixed-width integer types for the underlying type.
+
+// Define an enumeration class naming the closed set of shapes a body (or a piece of debris) can have.
+// Together with the extent of its bounding box, this is enough to rebuild the geometry without an `sf::Shape`.
+enum class ShapeKind : std::uint8_t {
+    Circle,   // Circle inscribed in the bounding box.
+    Square,   // Square filling the bounding box.
+    Triangle  // Triangle with its base on the top edge and its apex at the bottom-center of the bounding box.
+};
+
+#endif // SHAPE_KIND_H  // End of the include guard.
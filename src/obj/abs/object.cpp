@@ -1,53 +1,76 @@
 #include "object.h"  // Include the header file for the Object class.
+#include "../../render/ShapeGeometry.h"  // Include the helpers turning a shape into triangles.
 #include <cmath>     // Include the cmath library for mathematical functions like `std::abs`, `std::cos`, and `std::sin`.
+#include <algorithm> // Include `std::min` and `std::max`.
 
-// Static field definition: Initialize the static vector to store static objects.
-std::vector<sf::Shape*> Object::staticObjects;
+// Static field definition: Initialize the static pool to store static objects.
+DebrisPool Object::staticObjects;
+
+// Static field definition: The shared store holding the state of every body.
+BodyStore Object::bodies;
+
+// Register a new body in the store and remember its id.
+Object::Object(ShapeKind kind, sf::Vector2f position, sf::Color color, sf::Vector2f extent) {
+    id = bodies.add(kind, position, extent, color);
+}
 
 // Update the object's state based on physics calculations and elapsed time (deltaTime).
 void Object::update(float deltaTime) { 
-    velocity += acceleration * deltaTime / mass;  // Update velocity using acceleration and mass.
-    if (sh) {
-        sh->move(velocity * deltaTime);  // Move the shape based on the updated velocity.
-    }
+    if (bodies.isSleeping(id)) return;             // Resting bodies are not integrated.
+    float scale = deltaTime * bodies.invMass[id];  // Precomputed inverse mass: no division per step.
+    bodies.velX[id] += bodies.accX[id] * scale;    // Update velocity using acceleration and mass.
+    bodies.velY[id] += bodies.accY[id] * scale;
+    bodies.move(id, {bodies.velX[id] * deltaTime, bodies.velY[id] * deltaTime});  // Move the body based on the updated velocity.
 }
 
-// Draw the object on the SFML render window.
-void Object::draw(sf::RenderWindow& window) {
-    if (sh) {
-        window.draw(*sh);  // Render the shape if it exists.
-    }
+// Draw the object on an SFML render target.
+// Scenes should prefer `BodyRenderer`, which draws every body at once.
+void Object::draw(sf::RenderTarget& target) {
+    const sf::Vector2f extent(bodies.extX[id], bodies.extY[id]);
+    sf::VertexArray vertices(sf::Triangles);
+    appendShapeTriangles(vertices, bodies.kind[id], {bodies.posX[id], bodies.posY[id]}, extent, bodies.color[id],
+                         circleSegments(0.5f * std::max(extent.x, extent.y)));  // Built from the stored state.
+    target.draw(vertices);  // Render the shape.
 }
 
 // Handle collisions with the boundaries of the window.
 void Object::handleBoundaryCollision(const sf::RenderWindow& window) {
-    if (!sh) return;  // Exit early if the object has no shape.
+    handleBoundaryCollision(sf::Vector2f(window.getSize()));  // The world spans the whole window.
+}
 
-    auto bounds = sh->getGlobalBounds();  // Get the bounding box of the shape.
-    auto windowSize = window.getSize();   // Get the size of the render window.
+// Handle collisions with the boundaries of a world of the given size, anchored at (0, 0).
+void Object::handleBoundaryCollision(sf::Vector2f worldSize) {
+    handleBoundaryCollision(id, worldSize);
+}
+
+// Handle the boundary collisions of a body given by id, which may have no `Object` (e.g. restored from a snapshot).
+void Object::handleBoundaryCollision(std::size_t id, sf::Vector2f worldSize) {
+    auto bounds = bodies.getBounds(id);  // Get the cached bounding box of the body.
+    float& vx = bodies.velX[id];         // Velocity components are updated in place.
+    float& vy = bodies.velY[id];
 
     // Check collision with the left boundary.
     if (bounds.left <= 0) {
-        velocity.x = std::abs(velocity.x);  // Reverse horizontal velocity to bounce right.
-        sh->setPosition(0, bounds.top);     // Reposition the shape to avoid overlapping the boundary.
+        vx = std::abs(vx);                          // Reverse horizontal velocity to bounce right.
+        bodies.setPosition(id, {0, bounds.top});    // Reposition the body to avoid overlapping the boundary.
     }
 
     // Check collision with the right boundary.
-    if (bounds.left + bounds.width >= windowSize.x) {
-        velocity.x = -std::abs(velocity.x);  // Reverse horizontal velocity to bounce left.
-        sh->setPosition(windowSize.x - bounds.width, bounds.top);  // Reposition the shape.
+    if (bounds.left + bounds.width >= worldSize.x) {
+        vx = -std::abs(vx);  // Reverse horizontal velocity to bounce left.
+        bodies.setPosition(id, {worldSize.x - bounds.width, bounds.top});  // Reposition the body.
     }
 
     // Check collision with the top boundary.
     if (bounds.top <= 0) {
-        velocity.y = std::abs(velocity.y);  // Reverse vertical velocity to bounce downward.
-        sh->setPosition(bounds.left, 0);    // Reposition the shape.
+        vy = std::abs(vy);                          // Reverse vertical velocity to bounce downward.
+        bodies.setPosition(id, {bounds.left, 0});   // Reposition the body.
     }
 
     // Check collision with the bottom boundary.
-    if (bounds.top + bounds.height >= windowSize.y) {
-        velocity.y = -std::abs(velocity.y);  // Reverse vertical velocity to bounce upward.
-        sh->setPosition(bounds.left, windowSize.y - bounds.height);  // Reposition the shape.
+    if (bounds.top + bounds.height >= worldSize.y) {
+        vy = -std::abs(vy);  // Reverse vertical velocity to bounce upward.
+        bodies.setPosition(id, {bounds.left, worldSize.y - bounds.height});  // Reposition the body.
     }
 }
 
@@ -74,93 +97,141 @@ void Object::setGravity(Planets planet) {
             gravity = GRAVITY_EARTH;  // Default to Earth's gravity if an invalid planet is provided.
             break;
     }
-    this->acceleration.y = gravity * mass;  // Update the vertical acceleration based on gravity and mass.
+    bodies.accY[id] = gravity * bodies.mass[id];  // Update the vertical acceleration based on gravity and mass.
+    bodies.wake(id);  // The new force applies from the next step.
 }
 
 // Set the mass of the object.
 void Object::setMass(float mass) {
-    this->mass = mass;  // Assign the new mass value.
+    bodies.setMass(id, mass);  // Assign the new mass value (and its inverse).
 }
 
 // Get the mass of the object.
 float Object::getMass() {
-    return this->mass;  // Return the current mass.
+    return bodies.mass[id];  // Return the current mass.
 }
 
 // Resolve a collision between two objects.
 void Object::resolveCollision(Object& obj1, Object& obj2) {
-    float m1 = obj1.getMass();  // Mass of the first object.
-    float m2 = obj2.getMass();  // Mass of the second object.
+    resolveCollision(obj1.id, obj2.id);
+}
+
+// Resolve a collision between two bodies given by id (as emitted by the broadphase).
+void Object::resolveCollision(std::size_t a, std::size_t b) {
+    Debris debris1, debris2;
+    resolveCollision(a, b, debris1, debris2);
+    staticObjects.add(debris1);  // Add the static copy of the first object.
+    staticObjects.add(debris2);  // Add the static copy of the second object.
+}
 
-    sf::Vector2f v1 = obj1.velocity;  // Velocity of the first object.
-    sf::Vector2f v2 = obj2.velocity;  // Velocity of the second object.
+// Resolve a collision between two bodies and return the debris instead of storing it.
+// The contact is the exact one when the shapes overlap, the bounding box one otherwise.
+void Object::resolveCollision(std::size_t a, std::size_t b, Debris& debris1, Debris& debris2) {
+    Contact contact;
+    if (!checkCollision(a, b, contact)) {
+        contact = boxContact(bodies, a, b);
+    }
+    resolveCollision(a, b, contact, debris1, debris2);
+}
 
-    // Calculate new velocities after the collision using conservation of momentum and energy.
-    obj1.velocity = ((m1 - m2) * v1 + 2.0f * m2 * v2) / (m1 + m2);
-    obj2.velocity = ((m2 - m1) * v2 + 2.0f * m1 * v1) / (m1 + m2);
+// Penetration left uncorrected, so bodies resting on each other keep touching (and can sleep) instead of
+// being pushed apart and falling back every step.
+static constexpr float CONTACT_SLOP = 0.01f;
 
-    // Correct positions to prevent overlapping.
-    auto bounds1 = obj1.getBounds();  // Bounding box of the first object.
-    auto bounds2 = obj2.getBounds();  // Bounding box of the second object.
+// Approach speed below which an impact does not bounce, so bodies coming to rest settle into a contact.
+static constexpr float RESTING_SPEED = 1.0f;
 
-    sf::Vector2f overlap = {
-        std::min(bounds1.left + bounds1.width - bounds2.left, bounds2.left + bounds2.width - bounds1.left),
-        std::min(bounds1.top + bounds1.height - bounds2.top, bounds2.top + bounds2.height - bounds1.top)
-    };
+// Penetration of a resting contact deep enough to wake a sleeping body.
+static constexpr float WAKE_DEPTH = 10.0f * CONTACT_SLOP;
 
-    // Resolve overlap along the axis with the smallest penetration.
-    if (overlap.x < overlap.y) {
-        obj1.sh->move(-overlap.x, 0);  // Move the first object horizontally.
-        obj2.sh->move(overlap.x, 0);   // Move the second object horizontally.
+// Respond to a contact between two bodies.
+void Object::resolveCollision(std::size_t a, std::size_t b, Contact& contact, Debris& debris1, Debris& debris2) {
+    const sf::Vector2f n = contact.normal;
+
+    // Normal velocity of the second body relative to the first (negative when approaching).
+    const float approach = (bodies.velX[b] - bodies.velX[a]) * n.x + (bodies.velY[b] - bodies.velY[a]) * n.y;
+
+    // Only a new impact, a fast approach or a deep penetration wakes a sleeping body. Otherwise it holds
+    // like a static one, so bodies resting on it settle and fall asleep with it instead of waking it forever.
+    if (!contact.persistent || approach < -RESTING_SPEED || contact.depth > WAKE_DEPTH) {
+        bodies.wake(a);
+        bodies.wake(b);
+    }
+    const float invA = bodies.sleeping[a] ? 0.0f : bodies.invMass[a];  // Inverse masses: the lighter body
+    const float invB = bodies.sleeping[b] ? 0.0f : bodies.invMass[b];  // takes the larger share.
+    const float invSum = invA + invB;
+    if (invSum <= 0.0f) return;  // Both asleep: nothing to resolve.
+
+    // Correct positions to prevent overlapping, along the contact normal. The collision response decides
+    // itself whether the bodies wake, so the moves leave their sleep state alone.
+    const float correction = std::max(contact.depth - CONTACT_SLOP, 0.0f) / invSum;
+    if (correction > 0.0f) {
+        bodies.move(a, -n * (correction * invA), false);  // Move the first body back along the normal.
+        bodies.move(b, n * (correction * invB), false);   // Move the second body forward.
+    }
+    float impulse;
+    if (contact.persistent) {
+        // Resting contact: only cancel the approach left after the warm start, never pull the bodies together.
+        const float total = std::max(contact.impulse - approach / invSum, 0.0f);
+        impulse = total - contact.impulse;
+        contact.impulse = total;
     } else {
-        obj1.sh->move(0, -overlap.y);  // Move the first object vertically.
-        obj2.sh->move(0, overlap.y);   // Move the second object vertically.
+        // New impact: elastic bounce along the normal, conserving momentum and energy (no bounce when slow).
+        const float restitution = approach < -RESTING_SPEED ? 1.0f : 0.0f;
+        impulse = approach < 0.0f ? -(1.0f + restitution) * approach / invSum : 0.0f;
+        contact.impulse = impulse;
     }
+    bodies.velX[a] -= impulse * invA * n.x;
+    bodies.velY[a] -= impulse * invA * n.y;
+    bodies.velX[b] += impulse * invB * n.x;
+    bodies.velY[b] += impulse * invB * n.y;
+
+    if (contact.persistent) return;  // Debris and deformation mark the impact, not the resting contact.
 
     // Create static copies of the colliding objects to simulate "debris."
-    staticObjects.push_back(createStaticCopy(*obj1.sh));  // Add a static copy of the first object.
-    staticObjects.push_back(createStaticCopy(*obj2.sh));  // Add a static copy of the second object.
+    debris1 = createStaticCopy(a);  // Static copy of the first object.
+    debris2 = createStaticCopy(b);  // Static copy of the second object.
 
     // Reduce the size of the shapes by 5% to simulate deformation.
-    obj1.sh->setScale(obj1.sh->getScale() * 0.95f);
-    obj2.sh->setScale(obj2.sh->getScale() * 0.95f);
+    bodies.scale(a, 0.95f);
+    bodies.scale(b, 0.95f);
 }
 
-// Check if two objects are colliding by testing if their bounding boxes intersect.
+// Check if two objects are colliding.
 bool Object::checkCollision(const Object& obj1, const Object& obj2) {
-    return obj1.getBounds().intersects(obj2.getBounds());  // Return true if the bounding boxes overlap.
+    return checkCollision(obj1.id, obj2.id);
+}
+
+// Check if two bodies given by id are colliding: their shapes overlap, not just their bounding boxes.
+bool Object::checkCollision(std::size_t a, std::size_t b) {
+    Contact contact;
+    return checkCollision(a, b, contact);
+}
+
+// Exact test of two bodies, with the kernel of their pair of shapes.
+bool Object::checkCollision(std::size_t a, std::size_t b, Contact& contact) {
+    return collide(bodies, a, b, contact);
 }
 
 // Set the initial angle of the object, which determines its initial velocity direction.
 void Object::setInitialAngle(float angle) { 
     const float INITIAL_SPEED = 100.0f;  // Fixed initial speed for all objects.
     float radians = angle * 3.14159265358979323846f / 180.0f;  // Convert degrees to radians.
-    velocity.x = INITIAL_SPEED * std::cos(radians);  // Horizontal velocity component.
-    velocity.y = INITIAL_SPEED * std::sin(radians);  // Vertical velocity component.
+    bodies.velX[id] = INITIAL_SPEED * std::cos(radians);  // Horizontal velocity component.
+    bodies.velY[id] = INITIAL_SPEED * std::sin(radians);  // Vertical velocity component.
+    bodies.wake(id);  // A launched body must not stay asleep.
 }
 
-// Template function to create a static copy of a specific type of SFML shape.
-template <typename T>
-sf::Shape* Object::createStaticCopyImpl(const T& original) {
-    auto* copy = new T(original);  // Create a new instance of the same shape type.
-    copy->setPosition(original.getPosition());  // Copy the position of the original shape.
+// Create a static copy of a body from its stored state: its shape kind, bounds and color.
+Debris Object::createStaticCopy(std::size_t id) {
+    Debris copy;
+    copy.kind = bodies.kind[id];                          // Same shape as the body.
+    copy.position = {bodies.posX[id], bodies.posY[id]};   // Copy the position of the body.
+    copy.extent = {bodies.extX[id], bodies.extY[id]};     // Copy its current (scaled) size.
 
-    sf::Color color = original.getFillColor();  // Get the fill color of the original shape.
+    sf::Color color = bodies.color[id];  // Get the fill color of the body.
     color.a = 64;  // Reduce the opacity to make the static copy semi-transparent.
-    copy->setFillColor(color);  // Apply the modified color to the copy.
+    copy.color = color;  // Apply the modified color to the copy.
 
-    return copy;  // Return the pointer to the static copy.
-}
-
-// Create a static copy of an SFML shape by dynamically determining its type.
-sf::Shape* Object::createStaticCopy(const sf::Shape& original) {
-    // Use dynamic_cast to determine the type of the shape and call the appropriate template function.
-    if (auto circle = dynamic_cast<const sf::CircleShape*>(&original)) {
-        return createStaticCopyImpl(*circle);  // Handle CircleShape.
-    } else if (auto rect = dynamic_cast<const sf::RectangleShape*>(&original)) {
-        return createStaticCopyImpl(*rect);  // Handle RectangleShape.
-    } else if (auto convex = dynamic_cast<const sf::ConvexShape*>(&original)) {
-        return createStaticCopyImpl(*convex);  // Handle ConvexShape.
-    }
-    return nullptr;  // Return null if the shape type is unsupported.
+    return copy;  // Return the static copy by value: no allocation.
 }
@@ -4,25 +4,34 @@
 #include <SFML/Graphics.hpp>          // Include SFML graphics library for rendering shapes and handling windows.
 #include "enum/Enum.h"                // Include the `Planets` enum class for gravitational settings.
 #include "enum/gravity_constants.h"   // Include constants for gravitational acceleration values.
+#include "ShapeTraits.h"              // Include the closed set of shapes a body can have.
 #include <vector>                     // Include STL vector for managing lists of objects.
-#include <memory>                     // Include smart pointers (e.g., `std::unique_ptr`) for memory management.
+#include "../../world/BodyStore.h"    // Include the structure-of-arrays store that holds the state of every body.
+#include "../../debris/DebrisPool.h"  // Include the bounded pool that stores the debris left by collisions.
+#include "../../world/narrowphase/Narrowphase.h"  // Include the exact overlap tests and their `Contact`.
 
+// Lightweight handle to a body stored in `Object::bodies`.
+// The physical state lives in the shared structure-of-arrays store; the handle only keeps the body id.
 class Object {
 public:
-    // Constructor: Initializes an object with default velocity (0, 0) and acceleration (0, 9.8).
-    // The default acceleration corresponds to Earth's gravity.
-    Object(float angle = 0.0f) : velocity({0.0f, 0.0f}), acceleration({0.0f, 9.8f}) {}
+    Object(const Object&) = delete;             // Handles are unique: copying would alias the same body.
+    Object& operator=(const Object&) = delete;
 
     ~Object() = default;  // Default destructor for cleaning up resources.
 
-    // Static vector to store pointers to static objects (e.g., immovable obstacles).
-    static std::vector<sf::Shape*> staticObjects;
+    // Static pool storing the static objects (immovable debris), capped with ring eviction.
+    static DebrisPool staticObjects;
+
+    // Shared store holding the position, velocity, acceleration, mass and bounds of every body.
+    static BodyStore bodies;
 
     // Public methods:
     void setInitialAngle(float angle);  // Set the initial angle of the object (e.g., for projectile motion).
     void update(float deltaTime);       // Update the object's state based on physics and elapsed time.
-    void draw(sf::RenderWindow& window);  // Draw the object on the SFML render window.
+    void draw(sf::RenderTarget& target);  // Draw the object on an SFML render target (window or texture).
     void handleBoundaryCollision(const sf::RenderWindow& window);  // Handle collisions with window boundaries.
+    void handleBoundaryCollision(sf::Vector2f worldSize);           // Handle collisions with explicit world bounds.
+    static void handleBoundaryCollision(std::size_t id, sf::Vector2f worldSize);  // Same, for a body given by id.
     void setGravity(Planets planet);  // Set the gravitational force based on a celestial body (e.g., Earth, Mars).
     void setMass(float mass);         // Set the mass of the object (used in physics calculations).
     float getMass();                  // Get the mass of the object.
@@ -30,26 +39,37 @@ public:
     // Static methods for collision handling:
     static void resolveCollision(Object& obj1, Object& obj2);  // Resolve collisions between two objects.
     static bool checkCollision(const Object& obj1, const Object& obj2);  // Check if two objects are colliding.
+    static void resolveCollision(std::size_t a, std::size_t b);  // Resolve a collision between two bodies given by id.
+    // Resolve a collision between two bodies and hand back their debris instead of storing it (thread-safe for disjoint bodies).
+    static void resolveCollision(std::size_t a, std::size_t b, Debris& debris1, Debris& debris2);
+    static bool checkCollision(std::size_t a, std::size_t b);    // Check if two bodies given by id are colliding.
+
+    // Exact test of two bodies given by id; fills the normal and depth of `contact` when their shapes overlap.
+    static bool checkCollision(std::size_t a, std::size_t b, Contact& contact);
+    // Respond to a contact found by `checkCollision`: separate the bodies along the normal and apply the normal
+    // impulse (elastic for a new impact; for a persistent contact, the impulse needed on top of the warm start
+    // in `contact.impulse`, which receives the accumulated total). Only a new impact deforms the bodies and
+    // fills the debris. Only the two bodies are written, so disjoint contacts can be resolved concurrently.
+    static void resolveCollision(std::size_t a, std::size_t b, Contact& contact, Debris& debris1, Debris& debris2);
 
     // Getter for the bounding box of the object (used for collision detection and sorting).
     sf::FloatRect getBounds() const {
-        return sh ? sh->getGlobalBounds() : sf::FloatRect();  // Return the global bounds of the shape or an empty rectangle if no shape exists.
+        return bodies.getBounds(id);  // Return the cached bounding box from the body store.
     }
 
-protected:
-    std::unique_ptr<sf::Shape> sh;  // Unique pointer to the SFML shape representing the object (e.g., circle, square).
-    sf::Vector2f velocity;          // Velocity vector (x, y) of the object.
-    sf::Vector2f acceleration;      // Acceleration vector (x, y) of the object.
+    // Id of the body in `Object::bodies`.
+    std::size_t getId() const { return id; }
 
-private:
-    float mass = 1.0f;  // Mass of the object, initialized to 1.0 by default.
+protected:
+    // Constructor: Registers a new body in the store with default velocity (0, 0) and acceleration (0, 9.8).
+    // The default acceleration corresponds to Earth's gravity. `extent` is the unscaled size of the shape.
+    Object(ShapeKind kind, sf::Vector2f position, sf::Color color, sf::Vector2f extent);
 
-    // Private static method to create a static copy of an SFML shape (used for static objects).
-    static sf::Shape* createStaticCopy(const sf::Shape& original);
+    std::size_t id;  // Index of this object's body in `Object::bodies`.
 
-    // Template method for creating a static copy of a specific type of SFML shape.
-    template <typename T>
-    static sf::Shape* createStaticCopyImpl(const T& original);
+private:
+    // Private static method to create a static copy of a body (used for static objects).
+    static Debris createStaticCopy(std::size_t id);
 };
 
 #endif // OBJECT_H  // End of the include guard.
\ No newline at end of file
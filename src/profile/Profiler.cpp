@@ -0,0 +1,192 @@
+#include "Profiler.h"  // Include the header file for the profiler.
+
+#ifdef ENGN_PROFILING
+
+#include <algorithm>  // Include `std::nth_element`.
+#include <chrono>     // Include the steady clock used for timestamps.
+#include <cstring>    // Include `std::strcmp` to match names across translation units.
+#include <fstream>    // Include file streams for the trace.
+#include <iomanip>    // Include stream manipulators for fixed precision.
+
+// Nanoseconds on the steady clock.
+static std::uint64_t steadyNanoseconds() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Profiler::Profiler() : epoch(steadyNanoseconds()) {}
+
+// The process-wide profiler, created on first use.
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+// Nanoseconds since the profiler was created.
+std::uint64_t Profiler::now() const {
+    return steadyNanoseconds() - epoch;
+}
+
+// Buffer of the calling thread; the registry lock is only taken the first time a thread records.
+Profiler::ThreadBuffer& Profiler::local() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threads.push_back(std::make_unique<ThreadBuffer>(static_cast<std::uint32_t>(threads.size())));
+        buffer = threads.back().get();
+    }
+    return *buffer;
+}
+
+// Store a timed scope in the calling thread's ring.
+void Profiler::record(const char* name, std::uint64_t start, std::uint64_t end) {
+    ThreadBuffer& buffer = local();
+    ProfileSample sample;
+    sample.name = name;
+    sample.start = start;
+    sample.duration = end - start;
+    sample.thread = buffer.id;
+    if (!buffer.ring.push(sample)) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);  // The collector is behind: lose the sample, never block.
+    }
+}
+
+// Store a counter value in the calling thread's ring.
+void Profiler::count(const char* name, double value) {
+    ThreadBuffer& buffer = local();
+    ProfileSample sample;
+    sample.name = name;
+    sample.start = now();
+    sample.value = value;
+    sample.thread = buffer.id;
+    sample.counter = true;
+    if (!buffer.ring.push(sample)) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Name the calling thread in traces.
+void Profiler::nameThread(const char* name) {
+    local().name = name;
+}
+
+// Find the series of a name, creating it on first use. Names are literals, so the pointer usually matches.
+Profiler::Series& Profiler::series(const char* name, bool counter) {
+    for (Series& s : allSeries) {
+        if (s.counter == counter && (s.name == name || std::strcmp(s.name, name) == 0)) {
+            return s;
+        }
+    }
+    allSeries.push_back({name, counter, {}, 0, 0.0, false});
+    allSeries.back().history.reserve(HISTORY_FRAMES);
+    return allSeries.back();
+}
+
+// Drain every ring into the per-frame totals (and the trace), then push the totals into the histories.
+void Profiler::endFrame() {
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);  // Threads may register while we read the list.
+        collected.clear();  // Keeps the capacity: no allocation per frame.
+        for (auto& buffer : threads) collected.push_back(buffer.get());
+    }
+
+    ProfileSample sample;
+    for (ThreadBuffer* buffer : collected) {
+        while (buffer->ring.pop(sample)) {
+            Series& s = series(sample.name, sample.counter);
+            if (sample.counter) {
+                s.frameTotal = sample.value;  // Counters keep their latest value.
+            } else {
+                s.frameTotal += sample.duration * 1e-6;  // Stages add up, in milliseconds.
+            }
+            s.seen = true;
+
+            if (tracing) {
+                if (trace.size() < TRACE_CAPACITY) {
+                    trace.push_back(sample);
+                } else {
+                    ++traceDropped;
+                }
+            }
+        }
+    }
+
+    // Stages that did not run this frame (e.g. capture between video frames) keep their history as is.
+    for (Series& s : allSeries) {
+        if (!s.seen) continue;
+        if (s.history.size() < HISTORY_FRAMES) {
+            s.history.push_back(s.frameTotal);
+        } else {
+            s.history[s.next] = s.frameTotal;
+        }
+        s.next = (s.next + 1) % HISTORY_FRAMES;
+        s.frameTotal = 0.0;
+        s.seen = false;
+    }
+}
+
+// Rolling statistics of every series.
+std::vector<ProfileStats> Profiler::getStats() const {
+    std::vector<ProfileStats> stats;
+    std::vector<double> sorted;
+    for (const Series& s : allSeries) {
+        if (s.history.empty()) continue;
+        ProfileStats st;
+        st.name = s.name;
+        st.counter = s.counter;
+        st.last = s.history[(s.next + s.history.size() - 1) % s.history.size()];  // Most recent frame.
+
+        sorted = s.history;
+        const std::size_t median = sorted.size() / 2;
+        const std::size_t tail = std::min(sorted.size() - 1, sorted.size() * 99 / 100);
+        std::nth_element(sorted.begin(), sorted.begin() + median, sorted.end());
+        st.p50 = sorted[median];
+        std::nth_element(sorted.begin(), sorted.begin() + tail, sorted.end());
+        st.p99 = sorted[tail];
+        stats.push_back(st);
+    }
+    return stats;
+}
+
+// Samples lost to full rings or a full trace.
+std::uint64_t Profiler::samplesDropped() const {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::uint64_t dropped = traceDropped;
+    for (const auto& buffer : threads) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+// Write the trace as Chrome trace events: complete events ("X") for scopes, counter events ("C")
+// for counters and metadata events ("M") naming the threads. Timestamps are in microseconds.
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    out << std::fixed << std::setprecision(3);
+    bool first = true;
+    for (const auto& buffer : threads) {
+        if (!buffer->name) continue;
+        out << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << buffer->id
+            << ", \"args\": {\"name\": \"" << buffer->name << "\"}}";
+        first = false;
+    }
+    for (const ProfileSample& sample : trace) {
+        out << (first ? "" : ",\n");
+        first = false;
+        if (sample.counter) {
+            out << "{\"name\": \"" << sample.name << "\", \"ph\": \"C\", \"pid\": 0, \"tid\": " << sample.thread
+                << ", \"ts\": " << sample.start * 1e-3 << ", \"args\": {\"value\": " << sample.value << "}}";
+        } else {
+            out << "{\"name\": \"" << sample.name << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << sample.thread
+                << ", \"ts\": " << sample.start * 1e-3 << ", \"dur\": " << sample.duration * 1e-3 << "}";
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+#endif // ENGN_PROFILING
@@ -0,0 +1,135 @@
+#ifndef PROFILER_H  // Include guard to prevent multiple inclusions of this header file.
+#define PROFILER_H  // Define the macro `PROFILER_H` to ensure the file is included only once.
+
+// Instrumentation macros. They expand to nothing unless the build defines `ENGN_PROFILING`
+// (CMake option of the same name), so a build without profiling carries no trace of it.
+//   ENGN_PROFILE_SCOPE("name")          time the rest of the enclosing block as stage "name"
+//   ENGN_PROFILE_COUNTER("name", value) record a counter value for the current frame
+//   ENGN_PROFILE_THREAD("name")         name the calling thread in traces
+//   ENGN_PROFILE_FRAME()                close the frame: collect every thread's samples (one thread only)
+#ifdef ENGN_PROFILING
+
+#include "../capture/SpscRing.h"  // Include the lock-free ring each thread writes its samples into.
+#include <atomic>                 // Include atomics for the drop counter.
+#include <cstdint>                // Include fixed-width integer types for timestamps.
+#include <memory>                 // Include `std::unique_ptr` for the per-thread buffers.
+#include <mutex>                  // Include the mutex guarding thread registration.
+#include <string>                 // Include STL string for the trace path.
+#include <vector>                 // Include STL vector for histories and the trace.
+
+// One timed scope or counter value.
+struct ProfileSample {
+    const char* name = nullptr;  // Stage or counter name (a string literal, never copied).
+    std::uint64_t start = 0;     // Start time in nanoseconds since the profiler was created.
+    std::uint64_t duration = 0;  // Duration in nanoseconds (scopes only).
+    double value = 0.0;          // Counter value (counters only).
+    std::uint32_t thread = 0;    // Index of the thread that recorded the sample.
+    bool counter = false;        // Whether this is a counter rather than a scope.
+};
+
+// Rolling statistics of one stage or counter over the last frames.
+struct ProfileStats {
+    const char* name = nullptr;  // Stage or counter name.
+    bool counter = false;        // Counters report values, stages report milliseconds.
+    double last = 0.0;           // Value of the most recent frame.
+    double p50 = 0.0;            // Median over the window.
+    double p99 = 0.0;            // 99th percentile over the window.
+};
+
+// Collects samples from every thread with one lock-free ring per thread: recording never blocks
+// and never allocates after the first sample of a thread. Once per frame, one thread calls
+// `endFrame` to drain the rings into per-stage histories and, when tracing, into the trace.
+class Profiler {
+public:
+    static constexpr std::size_t RING_CAPACITY = 8192;     // Samples a thread can queue between two frames.
+    static constexpr std::size_t HISTORY_FRAMES = 240;     // Frames the percentiles are computed over.
+    static constexpr std::size_t TRACE_CAPACITY = 1 << 20; // Samples kept for the trace (older ones are dropped).
+
+    static Profiler& instance();  // The process-wide profiler.
+
+    std::uint64_t now() const;  // Nanoseconds since the profiler was created.
+
+    void record(const char* name, std::uint64_t start, std::uint64_t end);  // Store a timed scope.
+    void count(const char* name, double value);                             // Store a counter value.
+    void nameThread(const char* name);                                      // Name the calling thread.
+
+    // Drain every thread's ring: stages are summed per frame into their histories and counters keep
+    // their last value. Must always be called from the same thread.
+    void endFrame();
+
+    void setTracing(bool value) { tracing = value; }  // Keep every sample for `writeChromeTrace`.
+    bool isTracing() const { return tracing; }
+
+    // Write the kept samples in the Chrome trace event format (chrome://tracing, Perfetto).
+    // Returns false if the file cannot be written.
+    bool writeChromeTrace(const std::string& path) const;
+
+    std::vector<ProfileStats> getStats() const;  // Rolling statistics of every stage and counter, in first-seen order.
+    std::uint64_t samplesDropped() const;        // Samples lost because a ring or the trace was full.
+
+private:
+    Profiler();
+
+    // Samples of one thread, written by that thread only and read by `endFrame`.
+    struct ThreadBuffer {
+        ThreadBuffer(std::uint32_t id) : ring(RING_CAPACITY), id(id) {}
+        SpscRing<ProfileSample> ring;
+        std::uint32_t id;
+        const char* name = nullptr;
+        std::atomic<std::uint64_t> dropped{0};
+    };
+
+    // Per-frame history of one stage or counter.
+    struct Series {
+        const char* name;
+        bool counter;
+        std::vector<double> history;  // Circular window of frame values.
+        std::size_t next = 0;         // Next slot of `history` to overwrite.
+        double frameTotal = 0.0;      // Sum of the current frame's samples.
+        bool seen = false;            // Whether a sample arrived during the current frame.
+    };
+
+    ThreadBuffer& local();                               // Buffer of the calling thread (registered on first use).
+    Series& series(const char* name, bool counter);      // Find or create the series of a name.
+
+    const std::uint64_t epoch;                           // Clock value at creation.
+    mutable std::mutex registryMutex;                    // Guards `threads` while a thread registers.
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;  // One buffer per thread that ever recorded.
+    std::vector<Series> allSeries;                       // Stages and counters (collector thread only).
+    std::vector<ProfileSample> trace;                    // Kept samples when tracing (collector thread only).
+    std::vector<ThreadBuffer*> collected;                // Buffers drained by `endFrame` (collector thread only).
+    std::uint64_t traceDropped = 0;                      // Samples not kept because the trace was full.
+    bool tracing = false;                                // Whether samples are kept for the trace.
+};
+
+// Times the enclosing block and records it on destruction.
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), start(Profiler::instance().now()) {}
+    ~ProfileScope() { Profiler::instance().record(name, start, Profiler::instance().now()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    std::uint64_t start;
+};
+
+#define ENGN_PROFILE_JOIN2(a, b) a##b
+#define ENGN_PROFILE_JOIN(a, b) ENGN_PROFILE_JOIN2(a, b)
+#define ENGN_PROFILE_SCOPE(name) ProfileScope ENGN_PROFILE_JOIN(profileScope, __LINE__)(name)
+#define ENGN_PROFILE_COUNTER(name, value) Profiler::instance().count(name, static_cast<double>(value))
+#define ENGN_PROFILE_THREAD(name) Profiler::instance().nameThread(name)
+#define ENGN_PROFILE_FRAME() Profiler::instance().endFrame()
+
+#else // ENGN_PROFILING
+
+#define ENGN_PROFILE_SCOPE(name) ((void)0)
+#define ENGN_PROFILE_COUNTER(name, value) ((void)0)
+#define ENGN_PROFILE_THREAD(name) ((void)0)
+#define ENGN_PROFILE_FRAME() ((void)0)
+
+#endif // ENGN_PROFILING
+
+#endif // PROFILER_H  // End of the include guard.
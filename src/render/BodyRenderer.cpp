@@ -0,0 +1,58 @@
+#include "BodyRenderer.h"     // Include the header file for the BodyRenderer class.
+#include "ShapeGeometry.h"    // Include the helpers turning a shape into triangles.
+#include <algorithm>          // Include `std::max`.
+#include <cmath>              // Include `std::abs`.
+
+// Rebuild the geometry of the visible bodies.
+void BodyRenderer::build(const BodyStore& bodies, const sf::FloatRect& visibleArea, float pixelsPerUnit,
+                         const RenderInterpolation& interpolation) {
+    vertices.clear();  // Keeps the allocated capacity.
+    visible = 0;
+
+    const float left = visibleArea.left;
+    const float top = visibleArea.top;
+    const float right = visibleArea.left + visibleArea.width;
+    const float bottom = visibleArea.top + visibleArea.height;
+
+    const std::size_t n = bodies.size();
+    const bool interpolate = interpolation.previousX && interpolation.previousX->size() == n;
+    const float alpha = interpolation.alpha;
+    for (std::size_t i = 0; i < n; ++i) {
+        sf::Vector2f position(bodies.posX[i], bodies.posY[i]);
+        if (interpolate) {
+            const float px = (*interpolation.previousX)[i];
+            const float py = (*interpolation.previousY)[i];
+            position = {px + (position.x - px) * alpha, py + (position.y - py) * alpha};
+        }
+        const sf::Vector2f extent(bodies.extX[i], bodies.extY[i]);
+
+        // Cull bodies outside the view, with the box at the position they are drawn at: the cached bounds
+        // are those of the current step, which an interpolated body has not reached yet.
+        if (position.x + extent.x < left || position.x > right || position.y + extent.y < top || position.y > bottom) {
+            continue;
+        }
+        const sf::Color color = bodies.color[i];
+        visitShape(bodies.kind[i], [&](auto shape) {
+            std::size_t segments = 0;
+            if constexpr (decltype(shape)::value == ShapeKind::Circle) {
+                segments = circleSegments(0.5f * std::max(extent.x, extent.y) * pixelsPerUnit);  // Level of detail.
+            }
+            appendShapeTriangles(shape, vertices, position, extent, color, segments);
+        });
+        ++visible;
+    }
+}
+
+// Rebuild the geometry for the current view of the target and draw it.
+void BodyRenderer::draw(const BodyStore& bodies, sf::RenderTarget& target, const RenderInterpolation& interpolation) {
+    const sf::View& view = target.getView();
+    const sf::Vector2f center = view.getCenter();
+    const sf::Vector2f size = view.getSize();
+    const sf::FloatRect visibleArea(center.x - size.x / 2, center.y - size.y / 2, size.x, size.y);
+    const float pixelsPerUnit = size.x != 0.0f ? target.getSize().x / std::abs(size.x) : 1.0f;
+
+    build(bodies, visibleArea, pixelsPerUnit, interpolation);
+    if (vertices.getVertexCount() > 0) {
+        target.draw(vertices);  // A single draw call for every visible body.
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef BODY_RENDERER_H  // Include guard to prevent multiple inclusions of this header file.
+#define BODY_RENDERER_H  // Define the macro `BODY_RENDERER_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>         // Include SFML graphics for vertex arrays and render targets.
+#include "../world/BodyStore.h"      // Include the body store the geometry is built from.
+#include <cstddef>                   // Include `std::size_t`.
+#include <vector>                    // Include STL vector for the interpolation source.
+
+// Positions to draw instead of the current ones: previous + (current - previous) * alpha.
+// Used with a fixed physics step so motion stays smooth when frames fall between two steps.
+struct RenderInterpolation {
+    const std::vector<float>* previousX = nullptr;  // Positions before the last step (null = no interpolation).
+    const std::vector<float>* previousY = nullptr;
+    float alpha = 1.0f;                             // 0 = previous state, 1 = current state.
+};
+
+// Batched renderer for the dynamic bodies.
+// Every frame, the triangles of all visible bodies are written into one shared vertex array straight
+// from the body store and drawn with a single draw call, instead of one `window.draw` per shape.
+// Bodies outside the view are culled, and circles are tessellated according to their on-screen radius.
+class BodyRenderer {
+public:
+    // Rebuild the geometry of the bodies overlapping `visibleArea`; `pixelsPerUnit` converts world sizes
+    // to on-screen sizes for the circle level of detail.
+    void build(const BodyStore& bodies, const sf::FloatRect& visibleArea, float pixelsPerUnit,
+               const RenderInterpolation& interpolation = RenderInterpolation());
+
+    // Rebuild the geometry for the current view of `target` and draw it with one draw call.
+    void draw(const BodyStore& bodies, sf::RenderTarget& target,
+              const RenderInterpolation& interpolation = RenderInterpolation());
+
+    const sf::VertexArray& getVertices() const { return vertices; }  // Geometry of the last build.
+    std::size_t getVisibleCount() const { return visible; }           // Bodies drawn by the last build.
+
+private:
+    sf::VertexArray vertices{sf::Triangles};  // Shared geometry, its storage is reused between frames.
+    std::size_t visible = 0;                  // Bodies drawn by the last build.
+};
+
+#endif // BODY_RENDERER_H  // End of the include guard.
@@ -0,0 +1,86 @@
+#include "CpuFramebuffer.h"  // Include the header file for the CpuFramebuffer class.
+#include <algorithm>         // Include `std::min`, `std::max`.
+#include <cmath>             // Include `std::ceil`, `std::floor`.
+
+CpuFramebuffer::CpuFramebuffer(unsigned width, unsigned height)
+    : width(width), height(height), pixels(static_cast<std::size_t>(width) * height * 4) {}
+
+// Fill the whole buffer with one color.
+void CpuFramebuffer::clear(sf::Color color) {
+    for (std::size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i] = color.r;
+        pixels[i + 1] = color.g;
+        pixels[i + 2] = color.b;
+        pixels[i + 3] = color.a;
+    }
+}
+
+// Fill a convex shape by scanlines: on each pixel row, fill between the leftmost and rightmost edge crossing.
+void CpuFramebuffer::fillShape(const sf::Shape& shape) {
+    const std::size_t count = shape.getPointCount();
+    if (count < 3) return;
+
+    // Transform the local points into world (pixel) coordinates.
+    const sf::Transform& transform = shape.getTransform();
+    points.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        points[i] = transform.transformPoint(shape.getPoint(i));
+    }
+    fillPolygon(count, shape.getFillColor());
+}
+
+// Fill each triangle of a triangle list.
+void CpuFramebuffer::fillTriangles(const sf::VertexArray& triangles, float scale) {
+    if (triangles.getVertexCount() > 0) {
+        fillTriangles(&triangles[0], triangles.getVertexCount(), scale);
+    }
+}
+
+// Fill each triangle of a vertex range.
+void CpuFramebuffer::fillTriangles(const sf::Vertex* triangles, std::size_t count, float scale) {
+    points.resize(3);
+    for (std::size_t i = 0; i + 2 < count; i += 3) {
+        points[0] = triangles[i].position * scale;
+        points[1] = triangles[i + 1].position * scale;
+        points[2] = triangles[i + 2].position * scale;
+        fillPolygon(3, triangles[i].color);
+    }
+}
+
+// Fill the convex polygon stored in `points`.
+void CpuFramebuffer::fillPolygon(std::size_t count, sf::Color color) {
+    float top = static_cast<float>(height), bottom = 0.0f;
+    for (std::size_t i = 0; i < count; ++i) {
+        top = std::min(top, points[i].y);
+        bottom = std::max(bottom, points[i].y);
+    }
+
+    const unsigned alpha = color.a;
+    const int y0 = std::max(0, static_cast<int>(std::ceil(top - 0.5f)));
+    const int y1 = std::min(static_cast<int>(height) - 1, static_cast<int>(std::floor(bottom - 0.5f)));
+
+    for (int y = y0; y <= y1; ++y) {
+        const float sy = y + 0.5f;  // Sample at the pixel center.
+        float left = static_cast<float>(width), right = -1.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            const sf::Vector2f& a = points[i];
+            const sf::Vector2f& b = points[(i + 1) % count];
+            if ((a.y <= sy && b.y > sy) || (b.y <= sy && a.y > sy)) {  // The edge crosses this row.
+                float x = a.x + (sy - a.y) * (b.x - a.x) / (b.y - a.y);
+                left = std::min(left, x);
+                right = std::max(right, x);
+            }
+        }
+        const int x0 = std::max(0, static_cast<int>(std::ceil(left - 0.5f)));
+        const int x1 = std::min(static_cast<int>(width) - 1, static_cast<int>(std::floor(right - 0.5f)));
+
+        std::uint8_t* p = pixels.data() + (static_cast<std::size_t>(y) * width + x0) * 4;
+        for (int x = x0; x <= x1; ++x, p += 4) {
+            // Source-over blending, as SFML does for the semi-transparent debris.
+            p[0] = static_cast<std::uint8_t>((color.r * alpha + p[0] * (255 - alpha)) / 255);
+            p[1] = static_cast<std::uint8_t>((color.g * alpha + p[1] * (255 - alpha)) / 255);
+            p[2] = static_cast<std::uint8_t>((color.b * alpha + p[2] * (255 - alpha)) / 255);
+            p[3] = 255;
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef CPU_FRAMEBUFFER_H  // Include guard to prevent multiple inclusions of this header file.
+#define CPU_FRAMEBUFFER_H  // Define the macro `CPU_FRAMEBUFFER_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>  // Include SFML graphics for shapes and colors.
+#include <cstdint>            // Include fixed-width integer types for pixel data.
+#include <vector>             // Include STL vector for the pixel storage.
+
+// Minimal software rasterizer into an RGBA buffer (rows top to bottom).
+// Used by the headless mode to record video on machines without a GPU or display.
+class CpuFramebuffer {
+public:
+    CpuFramebuffer(unsigned width, unsigned height);
+
+    void clear(sf::Color color = sf::Color::Black);  // Fill the whole buffer with one color.
+    void fillShape(const sf::Shape& shape);          // Fill a convex SFML shape with its fill color (alpha-blended).
+    // Fill `sf::Triangles` with the color of their first vertex; positions are multiplied by `scale`
+    // (pixels per world unit).
+    void fillTriangles(const sf::VertexArray& triangles, float scale = 1.0f);
+    void fillTriangles(const sf::Vertex* triangles, std::size_t count, float scale = 1.0f);  // Same, from a range.
+
+    unsigned getWidth() const { return width; }
+    unsigned getHeight() const { return height; }
+    const std::uint8_t* getPixels() const { return pixels.data(); }  // RGBA pixels, top row first.
+
+private:
+    // Fill the convex polygon stored in `points` (alpha-blended).
+    void fillPolygon(std::size_t count, sf::Color color);
+
+    unsigned width;
+    unsigned height;
+    std::vector<std::uint8_t> pixels;  // RGBA pixels, top row first.
+    std::vector<sf::Vector2f> points;  // Transformed polygon, reused between shapes.
+};
+
+#endif // CPU_FRAMEBUFFER_H  // End of the include guard.
@@ -0,0 +1,70 @@
+#include "ProfilerOverlay.h"  // Include the header file for the ProfilerOverlay class.
+
+#ifdef ENGN_PROFILING
+
+#include "ShapeGeometry.h"    // Include the helper turning a rectangle into triangles.
+#include <algorithm>          // Include `std::min`.
+#include <cstdio>             // Include `std::snprintf` to format the rows.
+
+static constexpr float BUDGET_MS = 1000.0f / 60.0f;  // Frame budget at 60 fps, drawn as a reference line.
+static constexpr float ROW_HEIGHT = 16.0f;           // Height of one row in pixels.
+static constexpr float BAR_WIDTH = 200.0f;           // Width of a bar reaching the frame budget.
+static constexpr float LABEL_WIDTH = 260.0f;         // Space left of the bars for the text.
+static constexpr float MARGIN = 8.0f;                // Padding around the panel.
+
+// Append an axis-aligned rectangle to the triangle list.
+static void appendRect(sf::VertexArray& vertices, float x, float y, float w, float h, sf::Color color) {
+    appendShapeTriangles(vertices, ShapeKind::Square, {x, y}, {w, h}, color, 0);
+}
+
+// Load the font of the text.
+bool ProfilerOverlay::loadFont(const std::string& path) {
+    hasFont = font.loadFromFile(path);
+    return hasFont;
+}
+
+// Draw the panel over whatever the target shows.
+void ProfilerOverlay::draw(sf::RenderTarget& target, const Profiler& profiler) {
+    if (!visible) return;
+
+    const std::vector<ProfileStats> stats = profiler.getStats();
+    const float height = MARGIN * 2 + ROW_HEIGHT * stats.size();
+    const float width = MARGIN * 2 + LABEL_WIDTH + BAR_WIDTH * 1.5f;
+
+    bars.clear();
+    appendRect(bars, 0, 0, width, height, sf::Color(0, 0, 0, 180));  // Translucent background.
+
+    std::string text;
+    char line[128];
+    float y = MARGIN;
+    for (const ProfileStats& st : stats) {
+        if (st.counter) {
+            std::snprintf(line, sizeof(line), "%-14s %10.0f  p99 %10.0f\n", st.name, st.last, st.p99);
+        } else {
+            std::snprintf(line, sizeof(line), "%-14s p50 %6.2f  p99 %6.2f ms\n", st.name, st.p50, st.p99);
+            const float x = MARGIN + LABEL_WIDTH;
+            const float limit = BAR_WIDTH * 1.5f;  // Bars are clipped at 1.5 frame budgets.
+            const float p99 = std::min(limit, static_cast<float>(st.p99) / BUDGET_MS * BAR_WIDTH);
+            const float p50 = std::min(limit, static_cast<float>(st.p50) / BUDGET_MS * BAR_WIDTH);
+            appendRect(bars, x, y + ROW_HEIGHT * 0.55f, p99, ROW_HEIGHT * 0.3f, sf::Color(230, 80, 60));
+            appendRect(bars, x, y + ROW_HEIGHT * 0.15f, p50, ROW_HEIGHT * 0.4f, sf::Color(90, 200, 90));
+        }
+        text += line;
+        y += ROW_HEIGHT;
+    }
+    appendRect(bars, MARGIN + LABEL_WIDTH + BAR_WIDTH, MARGIN, 1.0f, height - MARGIN * 2, sf::Color::White);  // Budget line.
+
+    // Draw in screen coordinates, whatever view the scene uses.
+    const sf::View sceneView = target.getView();
+    target.setView(target.getDefaultView());
+    target.draw(bars);
+    if (hasFont) {
+        sf::Text label(text, font, static_cast<unsigned>(ROW_HEIGHT * 0.75f));
+        label.setPosition(MARGIN, MARGIN);
+        label.setFillColor(sf::Color::White);
+        target.draw(label);
+    }
+    target.setView(sceneView);
+}
+
+#endif // ENGN_PROFILING
@@ -0,0 +1,33 @@
+#ifndef PROFILER_OVERLAY_H  // Include guard to prevent multiple inclusions of this header file.
+#define PROFILER_OVERLAY_H  // Define the macro `PROFILER_OVERLAY_H` to ensure the file is included only once.
+
+#include "../profile/Profiler.h"  // Include the profiler whose statistics are shown.
+
+#ifdef ENGN_PROFILING
+
+#include <SFML/Graphics.hpp>  // Include SFML graphics for text, vertex arrays and render targets.
+#include <string>             // Include STL string for the font path.
+
+// On-screen panel with one row per stage: a bar for the rolling p50, a thinner one for the p99 and a
+// line at the 60 fps frame budget, plus the numbers as text when a font is available.
+// Counters (pairs, collisions, debris) are listed below the stages.
+class ProfilerOverlay {
+public:
+    bool loadFont(const std::string& path);  // Load the font of the text; without one only the bars are drawn.
+
+    void toggle() { visible = !visible; }    // Show or hide the panel.
+    bool isVisible() const { return visible; }
+
+    // Draw the panel in the top-left corner of `target`, in screen coordinates.
+    void draw(sf::RenderTarget& target, const Profiler& profiler);
+
+private:
+    sf::Font font;                          // Font of the numbers.
+    bool hasFont = false;                   // Whether `font` was loaded.
+    bool visible = true;                    // Whether the panel is drawn.
+    sf::VertexArray bars{sf::Triangles};    // Background and bars, drawn with one call.
+};
+
+#endif // ENGN_PROFILING
+
+#endif // PROFILER_OVERLAY_H  // End of the include guard.
@@ -0,0 +1,47 @@
+#include "ShapeGeometry.h"  // Include the header file for the shape geometry helpers.
+#include <algorithm>        // Include `std::clamp`.
+#include <array>            // Include STL array for the table of unit circles.
+#include <cmath>            // Include `std::cos`, `std::sin`, `std::sqrt`.
+#include <vector>           // Include STL vector for the cached unit circles.
+
+// Unit circle points for a segment count. Every table is built once, in a static initializer, so threads
+// rendering at the same time (e.g. the chunks of `Engn_replay`) only ever read them.
+static const std::vector<sf::Vector2f>& unitCircle(std::size_t segments) {
+    using Tables = std::array<std::vector<sf::Vector2f>, MAX_CIRCLE_SEGMENTS + 1>;
+    static const Tables tables = [] {
+        Tables built;
+        for (std::size_t count = MIN_CIRCLE_SEGMENTS; count <= MAX_CIRCLE_SEGMENTS; ++count) {
+            built[count].resize(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                float angle = static_cast<float>(i) * 2.0f * 3.14159265358979323846f / count;
+                built[count][i] = {std::cos(angle), std::sin(angle)};
+            }
+        }
+        return built;
+    }();
+    return tables[segments];
+}
+
+// Keep the distance between the true circle and each chord under about a quarter of a pixel.
+std::size_t circleSegments(float radius) {
+    if (radius <= 0.0f) return MIN_CIRCLE_SEGMENTS;
+    // Chord error is r * (1 - cos(pi / n)) ~ r * pi^2 / (2 n^2); solve for n with an error of 0.25 px.
+    float n = 3.14159265358979323846f * std::sqrt(radius * 2.0f);
+    return std::clamp(static_cast<std::size_t>(n), MIN_CIRCLE_SEGMENTS, MAX_CIRCLE_SEGMENTS);
+}
+
+// Append a fan of triangles around the center of the box.
+void appendShapeTriangles(ShapeTag<ShapeKind::Circle>, sf::VertexArray& vertices, sf::Vector2f position,
+                          sf::Vector2f extent, sf::Color color, std::size_t segments) {
+    segments = std::clamp(segments, MIN_CIRCLE_SEGMENTS, MAX_CIRCLE_SEGMENTS);
+    const std::vector<sf::Vector2f>& unit = unitCircle(segments);
+    const sf::Vector2f center(position.x + extent.x / 2, position.y + extent.y / 2);
+    const sf::Vector2f radius(extent.x / 2, extent.y / 2);
+    for (std::size_t i = 0; i < segments; ++i) {
+        const sf::Vector2f& p = unit[i];
+        const sf::Vector2f& q = unit[i + 1 == segments ? 0 : i + 1];
+        vertices.append(sf::Vertex(center, color));
+        vertices.append(sf::Vertex({center.x + p.x * radius.x, center.y + p.y * radius.y}, color));
+        vertices.append(sf::Vertex({center.x + q.x * radius.x, center.y + q.y * radius.y}, color));
+    }
+}
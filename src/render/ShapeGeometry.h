@@ -0,0 +1,39 @@
+#ifndef SHAPE_GEOMETRY_H  // Include guard to prevent multiple inclusions of this header file.
+#define SHAPE_GEOMETRY_H  // Define the macro `SHAPE_GEOMETRY_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>                // Include SFML graphics for vertices and colors.
+#include "../obj/abs/ShapeTraits.h"        // Include the compile-time description of each shape.
+#include <cstddef>                          // Include `std::size_t`.
+
+// Smallest and largest number of segments used to tessellate a circle.
+constexpr std::size_t MIN_CIRCLE_SEGMENTS = 6;
+constexpr std::size_t MAX_CIRCLE_SEGMENTS = 64;
+
+// Number of segments needed for a circle of the given on-screen radius (in pixels) to look round.
+std::size_t circleSegments(float radius);
+
+// Append the triangles (for `sf::Triangles`) of a circle inscribed in the box at `position` of size `extent`,
+// as a fan of `segments` triangles.
+void appendShapeTriangles(ShapeTag<ShapeKind::Circle>, sf::VertexArray& vertices, sf::Vector2f position,
+                          sf::Vector2f extent, sf::Color color, std::size_t segments);
+
+// Same for a polygonal shape: a fan over the outline given by its traits. Inlined, with the point count fixed.
+template <ShapeKind Kind>
+inline void appendShapeTriangles(ShapeTag<Kind>, sf::VertexArray& vertices, sf::Vector2f position, sf::Vector2f extent,
+                                 sf::Color color, std::size_t /*segments*/) {
+    using Traits = ShapeTraits<Kind>;
+    const sf::Vector2f first = position + Traits::point(0, extent);
+    for (std::size_t i = 1; i + 1 < Traits::pointCount; ++i) {
+        vertices.append(sf::Vertex(first, color));
+        vertices.append(sf::Vertex(position + Traits::point(i, extent), color));
+        vertices.append(sf::Vertex(position + Traits::point(i + 1, extent), color));
+    }
+}
+
+// Append the triangles of a shape whose kind is only known at run time (`segments` is only used for circles).
+inline void appendShapeTriangles(sf::VertexArray& vertices, ShapeKind kind, sf::Vector2f position, sf::Vector2f extent,
+                                 sf::Color color, std::size_t segments) {
+    visitShape(kind, [&](auto shape) { appendShapeTriangles(shape, vertices, position, extent, color, segments); });
+}
+
+#endif // SHAPE_GEOMETRY_H  // End of the include guard.
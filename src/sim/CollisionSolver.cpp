@@ -0,0 +1,113 @@
+#include "CollisionSolver.h"     // Include the header file for the CollisionSolver class.
+#include "../obj/abs/object.h"   // Include `Object` for the collision test and response.
+#include <algorithm>             // Include `std::max`.
+
+// Pairs per job: small enough to balance, large enough to amortize scheduling.
+static constexpr std::size_t PAIR_GRAIN = 256;
+
+// Sort the contacts into batches in which no body appears twice.
+void CollisionSolver::buildBatches(std::size_t bodyCount) {
+    lastBatch.assign(bodyCount, 0);
+    batchOf.resize(contacts.size());
+
+    // A contact goes into the batch right after the last batch touching either of its bodies.
+    std::uint32_t batchCount = 0;
+    for (std::size_t c = 0; c < contacts.size(); ++c) {
+        const std::size_t a = contacts[c].first;
+        const std::size_t b = contacts[c].second;
+        const std::uint32_t batch = std::max(lastBatch[a], lastBatch[b]);
+        batchOf[c] = batch;
+        lastBatch[a] = lastBatch[b] = batch + 1;
+        batchCount = std::max(batchCount, batch + 1);
+    }
+
+    // Stable counting sort by batch, so pair order is kept within each batch.
+    batchStart.assign(batchCount + 1, 0);
+    for (std::size_t c = 0; c < contacts.size(); ++c) {
+        ++batchStart[batchOf[c] + 1];
+    }
+    for (std::uint32_t k = 0; k < batchCount; ++k) {
+        batchStart[k + 1] += batchStart[k];
+    }
+    batched.resize(contacts.size());
+    std::vector<std::uint32_t> cursor(batchStart.begin(), batchStart.end() - 1);
+    for (std::size_t c = 0; c < contacts.size(); ++c) {
+        batched[cursor[batchOf[c]]++] = static_cast<std::uint32_t>(c);
+    }
+}
+
+// Test and resolve the candidate pairs on the pool.
+std::size_t CollisionSolver::solve(JobSystem& jobs, const std::vector<BodyPair>& pairs, std::size_t bodyCount,
+                                   bool deterministic, ContactCache& cache) {
+    contacts.clear();
+    if (deterministic) {
+        contacts = pairs;  // Every pair is tested at its turn, exactly like the serial loop.
+    } else {
+        // Test all pairs in parallel against the current state and keep only the colliding ones.
+        hits.resize(pairs.size());
+        jobs.parallelFor(pairs.size(), PAIR_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                hits[i] = Object::checkCollision(pairs[i].first, pairs[i].second) ? 1 : 0;
+            }
+        });
+        for (std::size_t i = 0; i < pairs.size(); ++i) {
+            if (hits[i]) contacts.push_back(pairs[i]);
+        }
+    }
+    cache.begin(contacts.size());
+    if (contacts.empty()) {
+        cache.end(Object::bodies);
+        return 0;
+    }
+
+    buildBatches(bodyCount);
+    resolved.assign(contacts.size(), 0);
+    if (deterministic) {
+        debris.resize(contacts.size() * 2);
+    }
+
+    // Batches run in order; the contacts of one batch touch disjoint bodies and run in parallel.
+    const std::size_t batchCount = batchStart.size() - 1;
+    for (std::size_t k = 0; k < batchCount; ++k) {
+        const std::uint32_t first = batchStart[k];
+        const std::uint32_t count = batchStart[k + 1] - first;
+        jobs.parallelFor(count, PAIR_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::uint32_t c = batched[first + i];
+                const std::size_t a = contacts[c].first;
+                const std::size_t b = contacts[c].second;
+                // Earlier batches may have separated this pair, so check again before resolving.
+                Contact contact;
+                if (!Object::checkCollision(a, b, contact)) continue;
+
+                cache.prepare(contacts[c], contact);
+                Debris debris1, debris2;
+                Object::resolveCollision(a, b, contact, debris1, debris2);
+                cache.record(c, contacts[c], contact);
+                resolved[c] = contact.persistent ? 1 : 2;
+                if (contact.persistent) continue;  // Only new impacts leave debris.
+                if (deterministic) {
+                    debris[2 * c] = debris1;      // Stored in pair order after all batches.
+                    debris[2 * c + 1] = debris2;
+                } else {
+                    std::lock_guard<std::mutex> lock(debrisMutex);
+                    Object::staticObjects.add(debris1);
+                    Object::staticObjects.add(debris2);
+                }
+            }
+        });
+    }
+
+    // Count the collisions and, in deterministic mode, store the debris in the serial order.
+    std::size_t collisions = 0;
+    for (std::size_t c = 0; c < contacts.size(); ++c) {
+        if (!resolved[c]) continue;
+        ++collisions;
+        if (deterministic && resolved[c] == 2) {
+            Object::staticObjects.add(debris[2 * c]);
+            Object::staticObjects.add(debris[2 * c + 1]);
+        }
+    }
+    cache.end(Object::bodies);
+    return collisions;
+}
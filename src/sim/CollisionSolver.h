@@ -0,0 +1,45 @@
+#ifndef COLLISION_SOLVER_H  // Include guard to prevent multiple inclusions of this header file.
+#define COLLISION_SOLVER_H  // Define the macro `COLLISION_SOLVER_H` to ensure the file is included only once.
+
+#include "../jobs/JobSystem.h"               // Include the thread pool the work is spread over.
+#include "../world/broadphase/Broadphase.h"  // Include `BodyPair`.
+#include "../debris/DebrisPool.h"           // Include the `Debris` records produced by collisions.
+#include "../world/narrowphase/ContactCache.h"  // Include the contacts warm-started and recorded by the solver.
+#include <cstdint>                           // Include fixed-width integer types.
+#include <mutex>                             // Include the mutex guarding debris in non-deterministic mode.
+#include <vector>                            // Include STL vector for the batches.
+
+// Multithreaded narrowphase and collision resolution.
+// The pairs are split into batches so that no body appears twice in a batch: batch k holds the
+// pairs whose bodies were last touched in batch k - 1 or earlier, in pair order. Batches run one
+// after another and the pairs of a batch run in parallel, so two workers never write the same body
+// and each body still sees its collisions in the same order as the serial loop.
+class CollisionSolver {
+public:
+    // Resolve the candidate pairs on the given pool.
+    // Deterministic mode: all pairs are batched and tested in place, and debris is stored in pair order,
+    //   so the result is bit-for-bit identical to the serial loop whatever the thread count.
+    // Otherwise: pairs are first tested in parallel against the state at the start of the step and only
+    //   the colliding ones are batched (pairs that only start touching during resolution are skipped until
+    //   the next step), and debris is stored in completion order.
+    // Persistent contacts are looked up in `cache` and this step's contacts are recorded into it.
+    // Returns the number of collisions resolved.
+    std::size_t solve(JobSystem& jobs, const std::vector<BodyPair>& pairs, std::size_t bodyCount, bool deterministic,
+                      ContactCache& cache);
+
+private:
+    // Sort `contacts` into batches without repeated bodies (fills `batchStart` and `batched`).
+    void buildBatches(std::size_t bodyCount);
+
+    std::vector<BodyPair> contacts;          // Pairs to resolve, in pair order.
+    std::vector<std::uint8_t> hits;          // Per-pair result of the parallel pre-test.
+    std::vector<std::uint32_t> batchOf;      // Batch index of each contact.
+    std::vector<std::uint32_t> lastBatch;    // Per body: 1 + batch of its last contact (0 = none yet).
+    std::vector<std::uint32_t> batchStart;   // Start offset of each batch in `batched`.
+    std::vector<std::uint32_t> batched;      // Contact indices grouped by batch, pair order within a batch.
+    std::vector<Debris> debris;              // Debris per contact (2 slots each) in deterministic mode.
+    std::vector<std::uint8_t> resolved;      // Per contact: 0 = not resolved, 1 = persistent contact, 2 = new impact.
+    std::mutex debrisMutex;                  // Guards `Object::staticObjects` in non-deterministic mode.
+};
+
+#endif // COLLISION_SOLVER_H  // End of the include guard.
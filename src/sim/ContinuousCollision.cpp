@@ -0,0 +1,180 @@
+#include "ContinuousCollision.h"  // Include the header file for the continuous collision pass.
+#include "../obj/abs/object.h"    // Include `Object::resolveCollision` used at the time of impact.
+#include <algorithm>              // Include `std::min`, `std::max`.
+#include <cmath>                  // Include `std::abs`, `std::sqrt`.
+#include <limits>                 // Include infinity for the axis intervals.
+
+// Record the fast bodies and where they start.
+void ContinuousCollision::begin(const BodyStore& bodies, float deltaTime, float fraction) {
+    fast.clear();
+    const std::size_t n = bodies.size();
+    fastSlot.assign(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (bodies.sleeping[i]) continue;
+        // Velocity the integrator is about to use, and the distance it covers in the step.
+        const float vx = bodies.velX[i] + bodies.accX[i] * bodies.invMass[i] * deltaTime;
+        const float vy = bodies.velY[i] + bodies.accY[i] * bodies.invMass[i] * deltaTime;
+        const float reach = fraction * std::min(bodies.extX[i], bodies.extY[i]);
+        if ((vx * vx + vy * vy) * deltaTime * deltaTime > reach * reach) {
+            fast.push_back({i, bodies.posX[i], bodies.posY[i], 0.0f, 0.0f});
+            fastSlot[i] = static_cast<std::uint32_t>(fast.size());
+        }
+    }
+}
+
+// Widen the bounds of the fast bodies to cover their whole path.
+void ContinuousCollision::sweepBounds(BodyStore& bodies) {
+    for (const FastBody& f : fast) {
+        bodies.minX[f.id] = std::min(f.startX, bodies.posX[f.id]);
+        bodies.minY[f.id] = std::min(f.startY, bodies.posY[f.id]);
+        bodies.maxX[f.id] = std::max(f.startX, bodies.posX[f.id]) + bodies.extX[f.id];
+        bodies.maxY[f.id] = std::max(f.startY, bodies.posY[f.id]) + bodies.extY[f.id];
+    }
+}
+
+// Entry and exit times along one axis of a box [aMin, aMax] moving by `d` towards the fixed [bMin, bMax].
+// Returns false if the boxes never overlap on this axis during the step.
+static bool axisInterval(float aMin, float aMax, float bMin, float bMax, float d, float& entry, float& exit) {
+    if (d == 0.0f) {
+        entry = -std::numeric_limits<float>::infinity();
+        exit = std::numeric_limits<float>::infinity();
+        return aMax > bMin && aMin < bMax;  // Not moving on this axis: overlap now or never.
+    }
+    const float t1 = (bMin - aMax) / d;
+    const float t2 = (bMax - aMin) / d;
+    entry = std::min(t1, t2);
+    exit = std::max(t1, t2);
+    return true;
+}
+
+// Resolve the first impact of every fast body at its time of impact.
+std::size_t ContinuousCollision::resolve(BodyStore& bodies, std::vector<BodyPair>& pairs) {
+    if (fast.empty()) return 0;
+
+    // Restore the true bounds first: the narrowphase and the impact tests below work on real boxes.
+    // The end positions are kept aside since resolving one impact can move a body hit later on.
+    for (FastBody& f : fast) {
+        bodies.refreshBounds(f.id);
+        f.endX = bodies.posX[f.id];
+        f.endY = bodies.posY[f.id];
+    }
+
+    impactTime.assign(fast.size(), 2.0f);  // > 1: no impact during the step.
+    impactWith.assign(fast.size(), 0);
+    handled.assign(bodies.size(), 0);
+
+    // Start position and displacement of a body over the step. Slow bodies, and bodies already placed by a
+    // resolved impact, are treated as fixed where they are.
+    auto motion = [&](std::size_t id, float& x, float& y, float& dx, float& dy) {
+        const std::uint32_t slot = fastSlot[id];
+        if (slot && !handled[id]) {
+            const FastBody& f = fast[slot - 1];
+            x = f.startX;
+            y = f.startY;
+            dx = f.endX - x;
+            dy = f.endY - y;
+        } else {
+            x = bodies.posX[id];
+            y = bodies.posY[id];
+            dx = dy = 0.0f;
+        }
+    };
+
+    // Time of impact of two bodies (fraction of the step). Returns false if they do not meet during the step,
+    // or already overlap at its start (left to the narrowphase).
+    auto timeOfImpact = [&](std::size_t a, std::size_t b, float& entry) {
+        float ax, ay, adx, ady, bx, by, bdx, bdy;
+        motion(a, ax, ay, adx, ady);
+        motion(b, bx, by, bdx, bdy);
+
+        // Move `a` relative to `b` and intersect the per-axis overlap intervals.
+        float entryX, exitX, entryY, exitY;
+        if (!axisInterval(ax, ax + bodies.extX[a], bx, bx + bodies.extX[b], adx - bdx, entryX, exitX) ||
+            !axisInterval(ay, ay + bodies.extY[a], by, by + bodies.extY[b], ady - bdy, entryY, exitY)) {
+            return false;
+        }
+        entry = std::max(entryX, entryY);
+        const float exit = std::min(exitX, exitY);
+        return entry <= exit && entry >= 0.0f && entry <= 1.0f;
+    };
+
+    for (const BodyPair& pair : pairs) {
+        const std::size_t a = pair.first;
+        const std::size_t b = pair.second;
+        if (!fastSlot[a] && !fastSlot[b]) continue;
+
+        float entry;
+        if (!timeOfImpact(a, b, entry)) continue;
+
+        // Keep the earliest impact of each fast body involved.
+        for (std::size_t id : {a, b}) {
+            const std::uint32_t slot = fastSlot[id];
+            if (slot && entry < impactTime[slot - 1]) {
+                impactTime[slot - 1] = entry;
+                impactWith[slot - 1] = id == a ? b : a;
+            }
+        }
+    }
+
+    // Move each fast body that hit something (and its partner, if fast too) back to the time of impact,
+    // in body order so the result does not depend on the pair order. A body is placed once: later impacts
+    // never rewind it, and an impact whose partner was already placed is recomputed against where it is now.
+    resolved.clear();
+    for (std::size_t k = 0; k < fast.size(); ++k) {
+        float t = impactTime[k];
+        const std::size_t a = fast[k].id;
+        const std::size_t b = impactWith[k];
+        if (t > 1.0f || handled[a]) continue;
+        if (handled[b] && !timeOfImpact(a, b, t)) continue;  // Missed it from there: left to the narrowphase.
+
+        // The boxes meet at `t`, but the shapes may meet later or not at all (e.g. a circle passing a corner):
+        // march the rest of the step with the exact kernel and take the first time the shapes overlap.
+        float ax, ay, adx, ady, bx, by, bdx, bdy;
+        motion(a, ax, ay, adx, ady);
+        motion(b, bx, by, bdx, bdy);
+        const sf::Vector2f endA(bodies.posX[a], bodies.posY[a]);
+        const sf::Vector2f endB(bodies.posX[b], bodies.posY[b]);
+        const float path = std::sqrt((adx - bdx) * (adx - bdx) + (ady - bdy) * (ady - bdy)) * (1.0f - t);
+        const float reach = 0.25f * std::min({bodies.extX[a], bodies.extY[a], bodies.extX[b], bodies.extY[b]});
+        const int samples = reach > 0.0f ? std::max(1, static_cast<int>(std::min(std::ceil(path / reach), 64.0f))) : 1;
+
+        // Trial positions leave the sleep state alone: only a confirmed impact wakes the bodies.
+        auto place = [&](std::size_t id, sf::Vector2f position) {
+            bodies.posX[id] = position.x;
+            bodies.posY[id] = position.y;
+            bodies.refreshBounds(id);
+        };
+        Contact contact;
+        bool hit = false;
+        for (int s = 0; s <= samples && !hit; ++s) {
+            const float at = t + (1.0f - t) * s / samples;
+            place(a, {ax + adx * at, ay + ady * at});
+            place(b, {bx + bdx * at, by + bdy * at});
+            hit = collide(bodies, a, b, contact);
+        }
+        if (!hit) {
+            // Only the boxes crossed: no impact. Put both bodies back where the step left them.
+            place(a, endA);
+            place(b, endB);
+            continue;
+        }
+        bodies.wake(a);
+        bodies.wake(b);
+        handled[a] = 1;
+        handled[b] = 1;
+
+        // Bounce at the contact instead of after passing through.
+        Debris debris1, debris2;
+        Object::resolveCollision(a, b, contact, debris1, debris2);
+        Object::staticObjects.add(debris1);
+        Object::staticObjects.add(debris2);
+        resolved.emplace_back(std::min(a, b), std::max(a, b));
+    }
+
+    // The bodies now touch without overlapping; drop their pairs so rounding cannot resolve them twice.
+    std::sort(resolved.begin(), resolved.end());
+    pairs.erase(std::remove_if(pairs.begin(), pairs.end(), [&](const BodyPair& pair) {
+        return std::binary_search(resolved.begin(), resolved.end(), pair);
+    }), pairs.end());
+    return resolved.size();
+}
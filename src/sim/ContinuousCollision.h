@@ -0,0 +1,50 @@
+#ifndef CONTINUOUS_COLLISION_H  // Include guard to prevent multiple inclusions of this header file.
+#define CONTINUOUS_COLLISION_H  // Define the macro `CONTINUOUS_COLLISION_H` to ensure the file is included only once.
+
+#include "../world/BodyStore.h"              // Include the store whose fast bodies are swept.
+#include "../world/broadphase/Broadphase.h"  // Include `BodyPair`.
+#include <cstddef>                           // Include `std::size_t`.
+#include <cstdint>                           // Include `std::uint32_t` for the body slots.
+#include <vector>                            // Include STL vector for the fast body list.
+
+// Swept-AABB continuous collision for bodies moving more than a fraction of their size in one step.
+// Before integration the fast bodies and their start positions are recorded; after integration their
+// cached bounds are widened to the box swept during the step, so the broadphase pairs them with
+// everything on their path. Each fast body is then moved back to its earliest time of impact and the
+// collision is resolved there, instead of the body tunnelling through thin or small obstacles. The swept
+// boxes only find candidates: the impact is confirmed by marching the exact shape kernel from the time the
+// boxes meet, so a circle or triangle whose box merely clips another body's box passes by.
+class ContinuousCollision {
+public:
+    // Record the awake bodies whose predicted motion over `deltaTime` exceeds `fraction` of their smaller side.
+    void begin(const BodyStore& bodies, float deltaTime, float fraction = 0.5f);
+
+    // After integration: replace the cached bounds of the fast bodies by their swept boxes.
+    void sweepBounds(BodyStore& bodies);
+
+    // After the broadphase: find the earliest impact of every fast body among `pairs`, move the bodies back
+    // to it and resolve the collision there, then restore the true bounds of all fast bodies. Each body is
+    // placed by at most one impact per step.
+    // The pairs resolved here are removed from `pairs` so the narrowphase does not bounce them back.
+    // Returns the number of collisions resolved.
+    std::size_t resolve(BodyStore& bodies, std::vector<BodyPair>& pairs);
+
+    std::size_t getFastCount() const { return fast.size(); }  // Fast bodies of the current step.
+
+private:
+    // Fast body with its position at the start and at the end of the step.
+    struct FastBody {
+        std::size_t id;
+        float startX, startY;
+        float endX, endY;
+    };
+
+    std::vector<FastBody> fast;          // Fast bodies, by increasing id.
+    std::vector<std::uint32_t> fastSlot; // Per body: 1 + index in `fast`, 0 for slow bodies.
+    std::vector<float> impactTime;       // Per fast body: earliest time of impact (fraction of the step).
+    std::vector<std::size_t> impactWith; // Per fast body: body hit at that time.
+    std::vector<std::uint8_t> handled;   // Per body: 1 once an impact has placed it this step.
+    std::vector<BodyPair> resolved;      // Pairs resolved at their time of impact, sorted.
+};
+
+#endif // CONTINUOUS_COLLISION_H  // End of the include guard.
@@ -0,0 +1,120 @@
+#include "HeadlessRunner.h"             // Include the header file for the headless runner.
+#include "../render/CpuFramebuffer.h"   // Include the software rasterizer.
+#include "../render/BodyRenderer.h"     // Include the batched body renderer.
+#include "../profile/Profiler.h"        // Include the stage instrumentation.
+#include "../snapshot/Checkpointer.h"   // Include the background snapshot writer.
+#include <chrono>                       // Include the steady clock used to measure throughput.
+#include <memory>                       // Include `std::unique_ptr` for the optional render targets.
+
+// Simulate a fixed number of steps without a window.
+bool runHeadless(Simulation& simulation, const HeadlessSettings& settings, HeadlessReport& report) {
+    simulation.setWorldSize(settings.worldSize);
+
+    const bool recording = settings.raster != HeadlessRaster::None && settings.raster != HeadlessRaster::StateLog;
+    std::unique_ptr<StateRecorder> recorder;
+    std::unique_ptr<FrameCapture> capture;
+    std::unique_ptr<sf::RenderTexture> texture;
+    std::unique_ptr<CpuFramebuffer> framebuffer;
+
+    if (recording) {
+        capture = std::make_unique<FrameCapture>(settings.capture);
+        if (!capture->open()) {
+            return false;  // The caller reports the error.
+        }
+        if (settings.raster == HeadlessRaster::RenderTexture) {
+            texture = std::make_unique<sf::RenderTexture>();
+            if (!texture->create(settings.capture.width, settings.capture.height)) {
+                return false;
+            }
+            if (settings.bakeDebris) {
+                Object::staticObjects.enableBaking({settings.capture.width, settings.capture.height});
+            }
+        } else {
+            framebuffer = std::make_unique<CpuFramebuffer>(settings.capture.width, settings.capture.height);
+        }
+    }
+
+    if (settings.raster == HeadlessRaster::StateLog) {
+        recorder = std::make_unique<StateRecorder>(settings.stateLog);
+        if (!recorder->open(settings.worldSize, Object::staticObjects.capacity())) {
+            return false;
+        }
+    }
+
+    std::unique_ptr<Checkpointer> checkpointer;
+    if (!settings.checkpointPath.empty()) {
+        checkpointer = std::make_unique<Checkpointer>(settings.checkpointPath);
+    }
+    // Scene values of a checkpoint taken after `steps` steps of this run.
+    auto checkpointInfo = [&](std::size_t steps) {
+        SnapshotInfo info;
+        info.step = settings.firstStep + steps;
+        info.time = static_cast<double>(info.step) * settings.deltaTime;
+        info.worldSize = settings.worldSize;
+        return info;
+    };
+
+    BodyRenderer bodyRenderer;  // Builds the geometry of the bodies for both raster paths.
+    const sf::FloatRect worldArea(0.0f, 0.0f, settings.worldSize.x, settings.worldSize.y);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < settings.steps; ++i) {
+        ENGN_PROFILE_FRAME();  // Collect the samples of the previous step.
+        simulation.step(settings.deltaTime);
+        ENGN_PROFILE_COUNTER("debris", Object::staticObjects.size());
+
+        if (checkpointer && settings.checkpointEvery > 0 && (i + 1) % settings.checkpointEvery == 0) {
+            checkpointer->save(checkpointInfo(i + 1));  // Copied now, written in the background.
+        }
+
+        if (recorder) {
+            recorder->update(settings.deltaTime, Object::bodies, Object::staticObjects);  // A few bytes per body.
+        }
+
+        // Rasterize only the frames that are actually recorded.
+        if (!capture || !capture->advance(settings.deltaTime)) {
+            continue;
+        }
+
+        ENGN_PROFILE_SCOPE("raster");
+        if (texture) {
+            texture->clear();
+            bodyRenderer.draw(Object::bodies, *texture);  // Draw all dynamic objects in one call.
+            Object::staticObjects.draw(*texture);  // Draw all static objects in one call.
+            texture->display();
+            capture->capture(*texture);
+        } else {
+            framebuffer->clear();
+            bodyRenderer.build(Object::bodies, worldArea, 1.0f);  // One world unit per pixel.
+            framebuffer->fillTriangles(bodyRenderer.getVertices());
+            const DebrisVertices debris = Object::staticObjects.getVertices();
+            framebuffer->fillTriangles(debris.data, debris.count);  // Rasterize the live debris.
+            capture->capture(framebuffer->getPixels(), framebuffer->getWidth(), framebuffer->getHeight());
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    if (checkpointer) {
+        checkpointer->wait();                        // Let the last periodic checkpoint finish...
+        checkpointer->save(checkpointInfo(settings.steps));  // ...then save the final state to resume from.
+        checkpointer->wait();
+        report.checkpoints = checkpointer->checkpointsWritten();
+    }
+
+    if (recorder) {
+        recorder->close();
+        report.framesRecorded = recorder->framesRecorded();
+        report.bytesLogged = recorder->bytesWritten();
+    }
+    if (capture) {
+        capture->close();  // Wait for the encoder to finish the queued frames.
+        report.framesRecorded = capture->framesCaptured();
+    }
+    ENGN_PROFILE_FRAME();  // Collect the samples of the last step and of the encoder's backlog.
+    report.steps = settings.steps;
+    report.seconds = std::chrono::duration<double>(end - start).count();
+    report.stepsPerSecond = report.seconds > 0.0 ? report.steps / report.seconds : 0.0;
+    return true;
+}
@@ -0,0 +1,46 @@
+#ifndef HEADLESS_RUNNER_H  // Include guard to prevent multiple inclusions of this header file.
+#define HEADLESS_RUNNER_H  // Define the macro `HEADLESS_RUNNER_H` to ensure the file is included only once.
+
+#include "Simulation.h"                  // Include the simulation that is stepped.
+#include "../capture/FrameCapture.h"     // Include the video capture used for the recorded frames.
+#include "../statelog/StateLog.h"        // Include the state log recorded instead of frames.
+#include <string>                        // Include STL string for the checkpoint path.
+#include <cstdint>                       // Include fixed-width integer types for statistics.
+
+// Where recorded frames are rasterized in headless mode.
+enum class HeadlessRaster {
+    None,           // Do not record anything: simulate as fast as possible.
+    RenderTexture,  // Rasterize with the GPU into an `sf::RenderTexture` (needs an OpenGL context, not a window).
+    Cpu,            // Rasterize in software into a `CpuFramebuffer` (works on machines without a GPU).
+    StateLog        // Do not rasterize: log the body states, rendered into a video later by `Engn_replay`.
+};
+
+// Settings of a headless run.
+struct HeadlessSettings {
+    std::size_t steps = 10000;                 // Number of steps to simulate.
+    float deltaTime = 1.0f / 60.0f;            // Fixed step, in simulated seconds.
+    sf::Vector2f worldSize{800.0f, 600.0f};    // World bounds.
+    HeadlessRaster raster = HeadlessRaster::None;  // Where to rasterize recorded frames.
+    CaptureSettings capture;                   // Video settings used when recording (frame rate in simulated time).
+    StateLogSettings stateLog;                 // Log settings used with `HeadlessRaster::StateLog`.
+    bool bakeDebris = false;                   // Bake debris into a texture (only with `HeadlessRaster::RenderTexture`).
+    std::string checkpointPath;                // Snapshot written in the background during the run (empty = none).
+    std::size_t checkpointEvery = 600;         // Steps between two checkpoints; a last one is written at the end.
+    std::uint64_t firstStep = 0;               // Step count the run starts from (set when resuming from a snapshot).
+};
+
+// Result of a headless run.
+struct HeadlessReport {
+    std::size_t steps = 0;             // Steps simulated.
+    double seconds = 0.0;              // Wall-clock duration of the run.
+    double stepsPerSecond = 0.0;       // Simulation throughput.
+    std::uint64_t framesRecorded = 0;  // Frames rasterized and queued for encoding (or logged).
+    std::uint64_t bytesLogged = 0;     // Size of the state log.
+    std::uint64_t checkpoints = 0;     // Snapshots written.
+};
+
+// Simulate `settings.steps` fixed steps without a window, rasterizing only the frames being recorded.
+// Returns false if recording was requested but the video (or log) file could not be opened.
+bool runHeadless(Simulation& simulation, const HeadlessSettings& settings, HeadlessReport& report);
+
+#endif // HEADLESS_RUNNER_H  // End of the include guard.
@@ -0,0 +1,180 @@
+#include "Simulation.h"              // Include the header file for the Simulation class.
+#include "../world/Integrator.h"     // Include the batch integrator.
+#include "../profile/Profiler.h"     // Include the stage instrumentation.
+#include <algorithm>                 // Include `std::max` and `std::min`.
+#include <atomic>                    // Include the atomic counter of sleeping bodies.
+#include <cmath>                     // Include `std::sqrt` for the sleep threshold.
+
+Simulation::Simulation(BroadphaseType broadphaseType) : broadphase(createBroadphase(broadphaseType)) {}
+
+// Add an object to the simulated scene.
+void Simulation::add(Object& obj) {
+    objects.push_back(&obj);
+}
+
+// Bodies per integration job.
+static constexpr std::size_t INTEGRATE_GRAIN = 8192;
+
+// Use `count` threads for the step; a single thread runs the serial path without a pool.
+void Simulation::setThreadCount(unsigned count) {
+    if (count == 0) {
+        count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    jobs = count > 1 ? std::make_unique<JobSystem>(count) : nullptr;
+}
+
+// Enable the mutual gravity between bodies, or change its parameters.
+void Simulation::setNBodyGravity(const NBodySettings& settings) {
+    if (gravity) {
+        gravity->setSettings(settings);
+    } else {
+        gravity = std::make_unique<BarnesHutGravity>(settings);
+    }
+}
+
+// Advance the scene by one step, split into the configured number of substeps.
+void Simulation::step(float deltaTime) {
+    const float dt = deltaTime / substeps;
+    collisions = 0;
+    for (unsigned i = 0; i < substeps; ++i) {
+        substep(dt);
+    }
+    ENGN_PROFILE_COUNTER("pairs", pairs.size());
+    ENGN_PROFILE_COUNTER("collisions", collisions);
+    ENGN_PROFILE_COUNTER("sleeping", sleepingCount);
+}
+
+// Advance the scene by one substep.
+void Simulation::substep(float deltaTime) {
+    // Mutual gravity changes the velocities first; the uniform field is applied by the integrator.
+    if (gravity) {
+        gravity->apply(Object::bodies, deltaTime, jobs.get());
+    }
+
+    // Remember where the bodies that may tunnel this step start from.
+    if (continuous) {
+        ccd.begin(Object::bodies, deltaTime);
+    }
+
+    // Integrate every body and bounce it off the world bounds in one vectorized pass over the store.
+    {
+        ENGN_PROFILE_SCOPE("integrate");  // Includes the boundary handling, which is fused into the same pass.
+        if (jobs) {
+            const SimdLevel level = detectSimdLevel();
+            jobs->parallelFor(Object::bodies.size(), INTEGRATE_GRAIN, [&](std::size_t begin, std::size_t end) {
+                integrateBodies(Object::bodies, begin, end, deltaTime, worldSize, level);
+            });
+        } else {
+            integrateBodies(Object::bodies, deltaTime, worldSize);
+        }
+    }
+
+    // Find the pairs of bodies whose bounding boxes overlap, using the persistent broadphase.
+    // Fast bodies take part with the box they swept during the step.
+    {
+        ENGN_PROFILE_SCOPE("broadphase");
+        if (continuous) {
+            ccd.sweepBounds(Object::bodies);
+        }
+        broadphase->findPairs(Object::bodies, pairs);
+    }
+
+    {
+        ENGN_PROFILE_SCOPE("resolve");
+        if (continuous) {
+            collisions += ccd.resolve(Object::bodies, pairs);  // Impacts of fast bodies, at their time of impact.
+        }
+        contacts.warmStart(Object::bodies);  // Reapply last step's impulses to the contacts that persist.
+        collisions += resolve();
+    }
+
+    if (sleep.enabled) {
+        ENGN_PROFILE_SCOPE("sleep");
+        updateSleep(deltaTime);
+    }
+}
+
+// Resolve the collisions of the candidate pairs, on the thread pool when there is one.
+std::size_t Simulation::resolve() {
+    if (jobs) {
+        return solver.solve(*jobs, pairs, Object::bodies.size(), deterministic, contacts);
+    }
+
+    // Perform collision detection and resolution for the candidate pairs only.
+    std::size_t resolved = 0;
+    contacts.begin(pairs.size());
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+        const BodyPair& pair = pairs[i];
+        // Earlier resolutions may have separated this pair, so check again before resolving.
+        // A new impact or a deep or fast contact wakes a sleeping body; a resting one leaves it asleep.
+        Contact contact;
+        if (!Object::checkCollision(pair.first, pair.second, contact)) continue;
+
+        contacts.prepare(pair, contact);
+        Debris debris1, debris2;
+        Object::resolveCollision(pair.first, pair.second, contact, debris1, debris2);
+        if (!contact.persistent) {
+            Object::staticObjects.add(debris1);  // Only new impacts leave debris.
+            Object::staticObjects.add(debris2);
+        }
+        contacts.record(i, pair, contact);
+        ++resolved;
+    }
+    contacts.end(Object::bodies);
+    return resolved;
+}
+
+// Enable, tune or disable body sleeping.
+void Simulation::setSleep(const SleepSettings& settings) {
+    sleep = settings;
+    if (!sleep.enabled) {
+        for (std::size_t i = 0; i < Object::bodies.size(); ++i) {
+            Object::bodies.wake(i);
+        }
+        sleepingCount = 0;
+    }
+}
+
+// Put the bodies that stayed slow long enough to sleep, and wake sleeping bodies whose velocity was
+// changed from outside (e.g. by the mutual gravity). Each body only reads and writes its own state.
+void Simulation::updateSleep(float deltaTime) {
+    BodyStore& bodies = Object::bodies;
+    const std::uint16_t frames = static_cast<std::uint16_t>(std::min(sleep.frames, 65535u));
+    std::atomic<std::size_t> asleep{0};
+
+    auto update = [&](std::size_t begin, std::size_t end) {
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            // A body resting on a boundary gains up to |force| / mass * dt per step and loses it on the bounce;
+            // a body falling from rest exceeds twice that after a few steps and stays awake.
+            const float ax = bodies.accX[i] * bodies.invMass[i];
+            const float ay = bodies.accY[i] * bodies.invMass[i];
+            const float threshold = sleep.velocityThreshold + 2.0f * std::sqrt(ax * ax + ay * ay) * deltaTime;
+            const float speed2 = bodies.velX[i] * bodies.velX[i] + bodies.velY[i] * bodies.velY[i];
+            if (speed2 >= threshold * threshold) {
+                bodies.wake(i);  // Moving (or pushed while asleep): reset the count.
+                continue;
+            }
+            if (bodies.sleeping[i]) {
+                // Keep the velocity: contacts leave sleeping bodies alone, so only outside pulls (the mutual
+                // gravity) add to it, and a weak pull must build up over steps until it wakes the body.
+                ++count;
+                continue;
+            }
+            if (++bodies.stillFrames[i] >= frames) {
+                bodies.sleeping[i] = 1;  // Rested long enough: stop simulating it.
+                bodies.velX[i] = 0.0f;
+                bodies.velY[i] = 0.0f;
+                ++count;
+            }
+        }
+        asleep.fetch_add(count, std::memory_order_relaxed);
+    };
+
+    if (jobs) {
+        jobs->parallelFor(bodies.size(), INTEGRATE_GRAIN, update);
+    } else {
+        update(0, bodies.size());
+    }
+    sleepingCount = asleep.load();
+}
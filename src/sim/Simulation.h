@@ -0,0 +1,94 @@
+#ifndef SIMULATION_H  // Include guard to prevent multiple inclusions of this header file.
+#define SIMULATION_H  // Define the macro `SIMULATION_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>                 // Include SFML graphics for vectors.
+#include "../obj/abs/object.h"               // Include the `Object` class whose bodies are simulated.
+#include "../world/broadphase/Broadphase.h"  // Include the broadphase used to find candidate pairs.
+#include "../world/gravity/BarnesHut.h"     // Include the mutual gravity between bodies.
+#include "../jobs/JobSystem.h"               // Include the thread pool used by the parallel stages.
+#include "CollisionSolver.h"                 // Include the multithreaded collision resolution.
+#include "ContinuousCollision.h"             // Include the swept-AABB pass for fast bodies.
+#include "../world/narrowphase/ContactCache.h"  // Include the contacts kept between steps.
+#include <memory>                            // Include `std::unique_ptr` for the broadphase.
+#include <vector>                            // Include STL vector for the object list and pair list.
+
+// Parameters of body sleeping.
+struct SleepSettings {
+    bool enabled = true;              // Whether resting bodies are put to sleep.
+    float velocityThreshold = 1.0f;   // Resting speed (world units per second), on top of what the body's own
+                                      // force adds in a step, which it keeps gaining and losing against a boundary.
+    unsigned frames = 30;             // Consecutive resting steps before a body falls asleep.
+};
+
+// One physics step of the whole scene, independent of any window.
+// The world is the rectangle from (0, 0) to `worldSize`; it is set explicitly so the same
+// simulation runs in a window, in a render texture or with no rendering at all.
+class Simulation {
+public:
+    explicit Simulation(BroadphaseType broadphaseType = BroadphaseType::SweepAndPrune);
+
+    void add(Object& obj);                         // Add an object to the simulated scene.
+
+    // Number of threads used by the step (0 = one per hardware thread, 1 = serial).
+    void setThreadCount(unsigned count);
+    unsigned getThreadCount() const { return jobs ? jobs->getThreadCount() : 1; }
+
+    // Deterministic mode: multithreaded results are bit-for-bit identical to the serial path.
+    void setDeterministic(bool value) { deterministic = value; }
+    bool isDeterministic() const { return deterministic; }
+
+    // Make every body attract every other (on top of the per-object `Planets` gravity).
+    void setNBodyGravity(const NBodySettings& settings);
+    void disableNBodyGravity() { gravity.reset(); }
+    bool hasNBodyGravity() const { return gravity != nullptr; }
+
+    // Put bodies that stay slow for a number of steps to sleep: they are skipped by integration and never
+    // paired with each other, and wake up on a new impact, a fast or deep contact, or any change of their state.
+    // Disabling sleeping wakes every body.
+    void setSleep(const SleepSettings& settings);
+    const SleepSettings& getSleep() const { return sleep; }
+
+    void setWorldSize(sf::Vector2f size) { worldSize = size; }  // Set the world bounds.
+    sf::Vector2f getWorldSize() const { return worldSize; }
+
+    // Advance the scene by `deltaTime` seconds: integrate, bounce off the bounds, find and resolve collisions.
+    // Every body of `Object::bodies` is stepped, in `getSubsteps()` equal substeps.
+    void step(float deltaTime);
+
+    // Split every step into `count` substeps (at least 1), for stiffer or faster scenes.
+    void setSubsteps(unsigned count) { substeps = count > 0 ? count : 1; }
+    unsigned getSubsteps() const { return substeps; }
+
+    // Swept-AABB continuous collision for bodies moving more than half their size per substep (on by default).
+    void setContinuousCollision(bool value) { continuous = value; }
+    bool hasContinuousCollision() const { return continuous; }
+
+    const std::vector<Object*>& getObjects() const { return objects; }  // Objects of the scene.
+    std::size_t getPairCount() const { return pairs.size(); }          // Candidate pairs found by the last step.
+    std::size_t getCollisionCount() const { return collisions; }       // Collisions resolved by the last step (all substeps).
+    std::size_t getSleepingCount() const { return sleepingCount; }     // Bodies asleep after the last step.
+    std::size_t getContactCount() const { return contacts.size(); }    // Contacts kept for warm starting.
+
+private:
+    void substep(float deltaTime);  // One integration, broadphase and resolution pass.
+    std::size_t resolve();          // Narrowphase and collision resolution of the candidate pairs.
+    void updateSleep(float deltaTime);  // Count resting steps, put bodies to sleep and wake the pushed ones.
+
+    std::vector<Object*> objects;            // Objects of the scene (handles into `Object::bodies`).
+    std::unique_ptr<Broadphase> broadphase;  // Broadphase used to find candidate collision pairs.
+    std::vector<BodyPair> pairs;             // Candidate pairs, reused every step.
+    sf::Vector2f worldSize{800.0f, 600.0f};  // World bounds.
+    std::size_t collisions = 0;              // Collisions resolved by the last step.
+    std::size_t sleepingCount = 0;           // Bodies asleep after the last step.
+    SleepSettings sleep;                     // Body sleeping parameters.
+    unsigned substeps = 1;                   // Substeps per step.
+    bool continuous = true;                  // Whether fast bodies are swept.
+    ContinuousCollision ccd;                 // Swept-AABB pass for fast bodies.
+    std::unique_ptr<JobSystem> jobs;         // Thread pool (null when running serially).
+    std::unique_ptr<BarnesHutGravity> gravity;  // Mutual gravity (null when disabled).
+    CollisionSolver solver;                  // Parallel collision resolution.
+    ContactCache contacts;                   // Contacts of the last step, keyed by pair.
+    bool deterministic = true;               // Whether parallel results must match the serial path.
+};
+
+#endif // SIMULATION_H  // End of the include guard.
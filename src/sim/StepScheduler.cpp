@@ -0,0 +1,33 @@
+#include "StepScheduler.h"  // Include the header file for the fixed-step scheduler.
+#include <cmath>            // Include `std::fmod`.
+
+// Run the fixed steps covered by the accumulated frame time.
+unsigned StepScheduler::advance(Simulation& simulation, float frameTime) {
+    const BodyStore& bodies = Object::bodies;
+    const double step = settings.step;
+    accumulator += frameTime;
+
+    unsigned steps = 0;
+    while (accumulator >= step && steps < settings.maxStepsPerFrame) {
+        previousX = bodies.posX;  // State the frame will be interpolated from.
+        previousY = bodies.posY;
+        simulation.step(settings.step);
+        accumulator -= step;
+        ++steps;
+    }
+
+    // Too far behind: keep only the fraction of a step, so the next frame does not have to catch up.
+    if (accumulator >= step) {
+        const double kept = std::fmod(accumulator, step);
+        dropped += accumulator - kept;
+        accumulator = kept;
+    }
+
+    // Bodies added since the last step have no previous state: draw them where they are.
+    if (previousX.size() != bodies.size()) {
+        previousX = bodies.posX;
+        previousY = bodies.posY;
+    }
+    alpha = static_cast<float>(accumulator / step);
+    return steps;
+}
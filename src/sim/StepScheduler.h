@@ -0,0 +1,43 @@
+#ifndef STEP_SCHEDULER_H  // Include guard to prevent multiple inclusions of this header file.
+#define STEP_SCHEDULER_H  // Define the macro `STEP_SCHEDULER_H` to ensure the file is included only once.
+
+#include "Simulation.h"                 // Include the simulation that is stepped.
+#include "../render/BodyRenderer.h"     // Include `RenderInterpolation` handed to the renderer.
+#include <vector>                       // Include STL vector for the previous positions.
+
+// Settings of the fixed-step scheduler.
+struct TimestepSettings {
+    float step = 1.0f / 60.0f;        // Physics step in simulated seconds, whatever the frame rate.
+    unsigned maxStepsPerFrame = 8;    // Steps run at most per frame; time beyond that is dropped.
+};
+
+// Accumulator-based fixed timestep: frame times are added up and the simulation is stepped by the
+// fixed step as many times as they cover, so physics runs at the same rate and gives the same result
+// whatever the frame rate. A long frame (slow encoder write, window resize) only runs more steps, up
+// to `maxStepsPerFrame`; beyond that the time is dropped so a slow machine slows the simulation down
+// instead of falling into a spiral of ever longer frames. The time left over is used to interpolate
+// the drawn positions between the last two physics states.
+class StepScheduler {
+public:
+    explicit StepScheduler(const TimestepSettings& settings = TimestepSettings()) : settings(settings) {}
+
+    // Add a frame of `frameTime` seconds and run the steps that are due. Returns the number of steps run.
+    unsigned advance(Simulation& simulation, float frameTime);
+
+    // Fraction of a step between the last physics state and the frame being drawn, in [0, 1).
+    float getAlpha() const { return alpha; }
+
+    // Positions to draw: between the state before the last step and the current one.
+    RenderInterpolation getInterpolation() const { return {&previousX, &previousY, alpha}; }
+
+    double getDroppedTime() const { return dropped; }  // Seconds skipped to keep up with real time.
+
+private:
+    TimestepSettings settings;
+    double accumulator = 0.0;           // Frame time not simulated yet.
+    double dropped = 0.0;               // Frame time discarded by the step cap.
+    float alpha = 0.0f;                 // Interpolation factor of the last frame.
+    std::vector<float> previousX, previousY;  // Positions before the last step.
+};
+
+#endif // STEP_SCHEDULER_H  // End of the include guard.
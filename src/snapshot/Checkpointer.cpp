@@ -0,0 +1,71 @@
+#include "Checkpointer.h"          // Include the header file for the Checkpointer class.
+#include "../obj/abs/object.h"     // Include `Object::bodies` and `Object::staticObjects`.
+#include "../profile/Profiler.h"   // Include the stage instrumentation.
+
+Checkpointer::Checkpointer(const std::string& path) : path(path), writer(&Checkpointer::writerLoop, this) {}
+
+// Let the writer finish the staged copy, then stop it.
+Checkpointer::~Checkpointer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    writer.join();
+}
+
+// Copy the scene into the staging buffer unless the writer still owns it.
+bool Checkpointer::save(const SnapshotInfo& info) {
+    ENGN_PROFILE_SCOPE("checkpoint");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending) {
+            ++skipped;  // The writer is behind: never stall the loop for a checkpoint.
+            return false;
+        }
+    }
+
+    // The writer is idle, so the staging buffer is ours until `pending` is set.
+    stagedBodies = Object::bodies;                   // Column-wise copies into the existing capacity.
+    Object::staticObjects.copyRecords(stagedDebris);
+    stagedInfo = info;
+    stagedInfo.debrisCapacity = Object::staticObjects.capacity();
+    stagedInfo.debrisAdded = Object::staticObjects.totalAdded();
+    stagedInfo.debrisEvicted = Object::staticObjects.totalEvicted();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = true;
+    }
+    wakeUp.notify_one();
+    return true;
+}
+
+// Wait until nothing is staged any more.
+void Checkpointer::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return !pending; });
+}
+
+// Write each staged copy as it arrives.
+void Checkpointer::writerLoop() {
+    ENGN_PROFILE_THREAD("checkpoint");
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeUp.wait(lock, [this] { return pending || stopping; });
+        if (!pending) return;  // Stopping with nothing left to write.
+
+        lock.unlock();
+        {
+            ENGN_PROFILE_SCOPE("write");
+            if (writeSnapshot(path, stagedBodies, stagedDebris, stagedInfo)) {
+                ++written;
+            } else {
+                ++failed;
+            }
+        }
+        lock.lock();
+        pending = false;
+        done.notify_all();
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef CHECKPOINTER_H  // Include guard to prevent multiple inclusions of this header file.
+#define CHECKPOINTER_H  // Define the macro `CHECKPOINTER_H` to ensure the file is included only once.
+
+#include "Snapshot.h"          // Include the snapshot format written by the checkpoints.
+#include <atomic>              // Include atomics for the statistics.
+#include <condition_variable>  // Include the condition variable waking the writer.
+#include <cstdint>             // Include fixed-width integer types for the statistics.
+#include <mutex>               // Include the mutex guarding the staged state.
+#include <string>              // Include STL string for the output path.
+#include <thread>              // Include STL thread for the background writer.
+#include <vector>              // Include STL vector for the staged debris.
+
+// Periodic snapshots written in the background.
+// `save` copies the scene into a staging buffer (a `memcpy` per column, reusing the buffer's capacity) and
+// returns; a writer thread then writes the staged copy with `writeSnapshot`, so the loop only pays for the
+// copy. If the previous checkpoint is still being written, the new one is skipped rather than waited for.
+class Checkpointer {
+public:
+    explicit Checkpointer(const std::string& path);
+    ~Checkpointer();  // Finishes the pending write and stops the writer.
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    // Stage the current scene (`Object::bodies` and `Object::staticObjects`) for writing.
+    // Returns false if the checkpoint was skipped because the previous one is still being written.
+    bool save(const SnapshotInfo& info);
+
+    void wait();  // Block until the staged checkpoint, if any, is on disk.
+
+    std::uint64_t checkpointsWritten() const { return written.load(); }  // Snapshots completed.
+    std::uint64_t checkpointsSkipped() const { return skipped.load(); }  // Saves dropped while busy.
+    std::uint64_t checkpointsFailed() const { return failed.load(); }    // Writes that failed.
+
+private:
+    void writerLoop();  // Body of the writer thread.
+
+    std::string path;                        // Snapshot file, replaced by every checkpoint.
+    BodyStore stagedBodies;                  // Copy of the bodies being written.
+    std::vector<Debris> stagedDebris;        // Copy of the live debris being written.
+    SnapshotInfo stagedInfo;                 // Scene values of the staged copy.
+    bool pending = false;                    // Whether a staged copy waits for (or is being) written.
+    bool stopping = false;                   // Set when the checkpointer shuts down.
+    std::mutex mutex;                        // Guards `pending` and `stopping`.
+    std::condition_variable wakeUp;          // Signaled when a copy is staged or the writer must stop.
+    std::condition_variable done;            // Signaled when a staged copy has been written.
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<std::uint64_t> skipped{0};
+    std::atomic<std::uint64_t> failed{0};
+    std::thread writer;                      // Background writer (started last, after every member above).
+};
+
+#endif // CHECKPOINTER_H  // End of the include guard.
@@ -0,0 +1,435 @@
+#include "Snapshot.h"              // Include the header file for the snapshot format.
+#include "../obj/abs/object.h"     // Include `Object::bodies` and `Object::staticObjects` for the scene helpers.
+#include <algorithm>               // Include `std::reverse`.
+#include <cstring>                 // Include `std::memcpy`.
+#include <filesystem>              // Include `std::filesystem::rename` for the atomic replace.
+#include <fstream>                 // Include file streams for writing.
+#include <iostream>                // Include `std::cerr` for error reporting.
+#include <type_traits>             // Include `std::decay_t` for the column loader.
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>     // Include `open`.
+#include <sys/mman.h>  // Include `mmap`.
+#include <sys/stat.h>  // Include `fstat`.
+#include <unistd.h>    // Include `close` and `fsync`.
+#define ENGN_SNAPSHOT_POSIX
+#endif
+
+namespace {
+
+constexpr char MAGIC[8] = {'E', 'N', 'G', 'N', 'S', 'N', 'A', 'P'};
+constexpr std::size_t HEADER_SIZE = 88;       // Bytes of the fixed header, up to the column table.
+constexpr std::size_t TABLE_ENTRY_SIZE = 16;  // Bytes per column table entry.
+constexpr std::size_t ALIGNMENT = 64;         // Alignment of every column in the file.
+
+bool hostIsLittleEndian() {
+    const std::uint16_t one = 1;
+    unsigned char first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+// Little-endian encoding of the header fields, whatever the host byte order.
+void putBytes(std::vector<unsigned char>& out, std::uint64_t value, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+void putU32(std::vector<unsigned char>& out, std::uint32_t value) { putBytes(out, value, 4); }
+void putU64(std::vector<unsigned char>& out, std::uint64_t value) { putBytes(out, value, 8); }
+void putF32(std::vector<unsigned char>& out, float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, 4);
+    putU32(out, bits);
+}
+void putF64(std::vector<unsigned char>& out, double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, 8);
+    putU64(out, bits);
+}
+
+// Sequential little-endian decoding of the header fields.
+struct HeaderReader {
+    const unsigned char* p;
+
+    std::uint64_t bytes(std::size_t size) {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            value |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+        }
+        p += size;
+        return value;
+    }
+    std::uint32_t u32() { return static_cast<std::uint32_t>(bytes(4)); }
+    std::uint64_t u64() { return bytes(8); }
+    float f32() {
+        const std::uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, 4);
+        return value;
+    }
+    double f64() {
+        const std::uint64_t bits = u64();
+        double value;
+        std::memcpy(&value, &bits, 8);
+        return value;
+    }
+};
+
+// Reverse the bytes of every element of an array (only needed on big-endian hosts).
+void swapElements(unsigned char* data, std::size_t count, std::size_t size) {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::reverse(data + i * size, data + (i + 1) * size);
+    }
+}
+
+// Column to write: `count` elements of `elementSize` bytes at `data`.
+struct ColumnOut {
+    SnapshotColumn id;
+    std::uint32_t elementSize;
+    const void* data;
+    std::size_t count;
+    bool bytewise;  // Arrays of bytes (colors): no byte order to convert.
+};
+
+template <typename T>
+ColumnOut column(SnapshotColumn id, const std::vector<T>& values, bool bytewise = sizeof(T) == 1) {
+    return {id, static_cast<std::uint32_t>(sizeof(T)), values.data(), values.size(), bytewise};
+}
+
+std::size_t alignUp(std::size_t offset) {
+    return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+// Flush a file, or a directory, to the storage device. Returns false if it cannot be synced. Without POSIX
+// there is no portable way to do this, and the flush is left to the operating system.
+bool syncToDisk(const std::string& path) {
+#ifdef ENGN_SNAPSHOT_POSIX
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    const bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#else
+    (void)path;
+    return true;
+#endif
+}
+
+// Read-only view of a whole file: mapped where the platform supports it, read into memory otherwise.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef ENGN_SNAPSHOT_POSIX
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat status;
+        if (::fstat(fd, &status) == 0) {
+            length = static_cast<std::size_t>(status.st_size);
+            if (length == 0) {
+                opened = true;
+            } else {
+                void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping != MAP_FAILED) {
+                    ::madvise(mapping, length, MADV_SEQUENTIAL);  // Every column is read once, front to back.
+                    bytes = static_cast<const unsigned char*>(mapping);
+                    opened = true;
+                }
+            }
+        }
+        ::close(fd);  // The mapping stays valid after the descriptor is closed.
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) return;
+        buffer.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        opened = static_cast<bool>(in.read(reinterpret_cast<char*>(buffer.data()), buffer.size()));
+        bytes = buffer.data();
+        length = buffer.size();
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef ENGN_SNAPSHOT_POSIX
+        if (bytes) ::munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    const unsigned char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    const unsigned char* bytes = nullptr;
+    std::size_t length = 0;
+    bool opened = false;
+#ifndef ENGN_SNAPSHOT_POSIX
+    std::vector<unsigned char> buffer;  // File contents on platforms without `mmap`.
+#endif
+};
+
+}  // namespace
+
+// Write the header, the column table and every column.
+bool writeSnapshot(const std::string& path, const BodyStore& bodies, const std::vector<Debris>& debris,
+                   const SnapshotInfo& info) {
+    // Debris is stored as records; split it into columns like the bodies.
+    const std::size_t debrisCount = debris.size();
+    std::vector<ShapeKind> debrisKind(debrisCount);
+    std::vector<float> debrisPosX(debrisCount), debrisPosY(debrisCount), debrisExtX(debrisCount), debrisExtY(debrisCount);
+    std::vector<sf::Color> debrisColor(debrisCount);
+    for (std::size_t i = 0; i < debrisCount; ++i) {
+        debrisKind[i] = debris[i].kind;
+        debrisPosX[i] = debris[i].position.x;
+        debrisPosY[i] = debris[i].position.y;
+        debrisExtX[i] = debris[i].extent.x;
+        debrisExtY[i] = debris[i].extent.y;
+        debrisColor[i] = debris[i].color;
+    }
+
+    const ColumnOut columns[] = {
+        column(SnapshotColumn::PosX, bodies.posX),         column(SnapshotColumn::PosY, bodies.posY),
+        column(SnapshotColumn::VelX, bodies.velX),         column(SnapshotColumn::VelY, bodies.velY),
+        column(SnapshotColumn::AccX, bodies.accX),         column(SnapshotColumn::AccY, bodies.accY),
+        column(SnapshotColumn::Mass, bodies.mass),         column(SnapshotColumn::InvMass, bodies.invMass),
+        column(SnapshotColumn::ExtX, bodies.extX),         column(SnapshotColumn::ExtY, bodies.extY),
+        column(SnapshotColumn::Scale, bodies.scaleFactor), column(SnapshotColumn::Sleeping, bodies.sleeping),
+        column(SnapshotColumn::StillFrames, bodies.stillFrames), column(SnapshotColumn::Kind, bodies.kind),
+        column(SnapshotColumn::Color, bodies.color, true),
+        column(SnapshotColumn::DebrisKind, debrisKind),    column(SnapshotColumn::DebrisPosX, debrisPosX),
+        column(SnapshotColumn::DebrisPosY, debrisPosY),    column(SnapshotColumn::DebrisExtX, debrisExtX),
+        column(SnapshotColumn::DebrisExtY, debrisExtY),    column(SnapshotColumn::DebrisColor, debrisColor, true),
+    };
+    const std::size_t columnCount = sizeof(columns) / sizeof(columns[0]);
+
+    // Header.
+    std::vector<unsigned char> head;
+    head.insert(head.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    putU32(head, SNAPSHOT_VERSION);
+    putU32(head, static_cast<std::uint32_t>(HEADER_SIZE));
+    putU64(head, info.step);
+    putF64(head, info.time);
+    putF32(head, info.worldSize.x);
+    putF32(head, info.worldSize.y);
+    putU64(head, bodies.size());
+    putU64(head, debrisCount);
+    putU64(head, info.debrisCapacity);
+    putU64(head, info.debrisAdded);
+    putU64(head, info.debrisEvicted);
+    putU32(head, static_cast<std::uint32_t>(columnCount));
+    putU32(head, 0);  // Reserved.
+
+    // Column table: every column starts on a 64-byte boundary after the table.
+    std::size_t offsets[columnCount];
+    std::size_t offset = HEADER_SIZE + columnCount * TABLE_ENTRY_SIZE;
+    for (std::size_t c = 0; c < columnCount; ++c) {
+        offset = alignUp(offset);
+        offsets[c] = offset;
+        putU32(head, static_cast<std::uint32_t>(columns[c].id));
+        putU32(head, columns[c].elementSize);
+        putU64(head, offset);
+        offset += columns[c].count * columns[c].elementSize;
+    }
+
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Error: Cannot write the snapshot " << temporary << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(head.data()), static_cast<std::streamsize>(head.size()));
+
+        const bool swap = !hostIsLittleEndian();
+        std::vector<unsigned char> swapped;  // Byte-swapped copy of a column on big-endian hosts.
+        std::size_t written = head.size();
+        const char padding[ALIGNMENT] = {};
+        for (std::size_t c = 0; c < columnCount; ++c) {
+            const ColumnOut& col = columns[c];
+            out.write(padding, static_cast<std::streamsize>(offsets[c] - written));
+            const std::size_t bytes = col.count * col.elementSize;
+            const char* data = static_cast<const char*>(col.data);
+            if (swap && !col.bytewise && col.elementSize > 1) {
+                swapped.assign(static_cast<const unsigned char*>(col.data),
+                               static_cast<const unsigned char*>(col.data) + bytes);
+                swapElements(swapped.data(), col.count, col.elementSize);
+                data = reinterpret_cast<const char*>(swapped.data());
+            }
+            out.write(data, static_cast<std::streamsize>(bytes));
+            written = offsets[c] + bytes;
+        }
+        if (!out) {
+            std::cerr << "Error: Failed to write the snapshot " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    // The data must be on disk before the rename is: otherwise a power loss can leave the new name pointing
+    // at a file whose contents were never written.
+    if (!syncToDisk(temporary)) {
+        std::cerr << "Error: Failed to flush the snapshot " << temporary << std::endl;
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);  // Replaces the previous snapshot in one step.
+    if (error) {
+        std::cerr << "Error: Cannot replace " << path << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    // Then the directory, so the rename itself survives a power loss.
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    if (directory.empty()) directory = ".";
+    if (!syncToDisk(directory.string())) {
+        std::cerr << "Warning: Failed to flush the directory of " << path << std::endl;
+    }
+    return true;
+}
+
+// Map the file, validate the header and table, and copy every column into place.
+bool readSnapshot(const std::string& path, BodyStore& bodies, std::vector<Debris>& debris, SnapshotInfo& info) {
+    MappedFile file(path);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Cannot open the snapshot " << path << std::endl;
+        return false;
+    }
+    const unsigned char* data = file.data();
+    const std::size_t size = file.size();
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Error: " << path << " is not a snapshot" << std::endl;
+        return false;
+    }
+
+    HeaderReader header{data + sizeof(MAGIC)};
+    const std::uint32_t version = header.u32();
+    const std::uint32_t headerSize = header.u32();
+    if (version != SNAPSHOT_VERSION || headerSize < HEADER_SIZE) {
+        std::cerr << "Error: " << path << " has snapshot version " << version << ", expected " << SNAPSHOT_VERSION
+                  << std::endl;
+        return false;
+    }
+    SnapshotInfo loadedInfo;
+    loadedInfo.step = header.u64();
+    loadedInfo.time = header.f64();
+    loadedInfo.worldSize.x = header.f32();
+    loadedInfo.worldSize.y = header.f32();
+    const std::uint64_t bodyCount = header.u64();
+    const std::uint64_t debrisCount = header.u64();
+    loadedInfo.debrisCapacity = header.u64();
+    loadedInfo.debrisAdded = header.u64();
+    loadedInfo.debrisEvicted = header.u64();
+    const std::uint32_t columnCount = header.u32();
+    if (headerSize + static_cast<std::uint64_t>(columnCount) * TABLE_ENTRY_SIZE > size) {
+        std::cerr << "Error: " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    // Start of column `id`, checked to hold `count` elements of `elementSize` bytes inside the file.
+    auto find = [&](SnapshotColumn id, std::size_t elementSize, std::uint64_t count) -> const unsigned char* {
+        HeaderReader table{data + headerSize};
+        for (std::uint32_t c = 0; c < columnCount; ++c) {
+            const std::uint32_t columnId = table.u32();
+            const std::uint32_t columnElementSize = table.u32();
+            const std::uint64_t offset = table.u64();
+            if (columnId != static_cast<std::uint32_t>(id)) continue;
+            if (columnElementSize != elementSize || offset > size || count > (size - offset) / elementSize) {
+                return nullptr;
+            }
+            return data + offset;
+        }
+        return nullptr;
+    };
+
+    const bool swap = !hostIsLittleEndian();
+    bool complete = true;
+    // Copy a column into `out` (a missing or malformed column marks the snapshot as incomplete).
+    auto load = [&](SnapshotColumn id, std::uint64_t count, auto& out, bool bytewise = false) {
+        using T = typename std::decay_t<decltype(out)>::value_type;
+        const unsigned char* source = find(id, sizeof(T), count);
+        if (!source) {
+            complete = false;
+            return;
+        }
+        out.resize(static_cast<std::size_t>(count));
+        std::memcpy(out.data(), source, static_cast<std::size_t>(count) * sizeof(T));
+        if (swap && !bytewise && sizeof(T) > 1) {
+            swapElements(reinterpret_cast<unsigned char*>(out.data()), out.size(), sizeof(T));
+        }
+    };
+
+    BodyStore loaded;
+    load(SnapshotColumn::PosX, bodyCount, loaded.posX);
+    load(SnapshotColumn::PosY, bodyCount, loaded.posY);
+    load(SnapshotColumn::VelX, bodyCount, loaded.velX);
+    load(SnapshotColumn::VelY, bodyCount, loaded.velY);
+    load(SnapshotColumn::AccX, bodyCount, loaded.accX);
+    load(SnapshotColumn::AccY, bodyCount, loaded.accY);
+    load(SnapshotColumn::Mass, bodyCount, loaded.mass);
+    load(SnapshotColumn::InvMass, bodyCount, loaded.invMass);
+    load(SnapshotColumn::ExtX, bodyCount, loaded.extX);
+    load(SnapshotColumn::ExtY, bodyCount, loaded.extY);
+    load(SnapshotColumn::Scale, bodyCount, loaded.scaleFactor);
+    load(SnapshotColumn::Sleeping, bodyCount, loaded.sleeping);
+    load(SnapshotColumn::StillFrames, bodyCount, loaded.stillFrames);
+    load(SnapshotColumn::Kind, bodyCount, loaded.kind);
+    load(SnapshotColumn::Color, bodyCount, loaded.color, true);
+
+    std::vector<ShapeKind> debrisKind;
+    std::vector<float> debrisPosX, debrisPosY, debrisExtX, debrisExtY;
+    std::vector<sf::Color> debrisColor;
+    load(SnapshotColumn::DebrisKind, debrisCount, debrisKind);
+    load(SnapshotColumn::DebrisPosX, debrisCount, debrisPosX);
+    load(SnapshotColumn::DebrisPosY, debrisCount, debrisPosY);
+    load(SnapshotColumn::DebrisExtX, debrisCount, debrisExtX);
+    load(SnapshotColumn::DebrisExtY, debrisCount, debrisExtY);
+    load(SnapshotColumn::DebrisColor, debrisCount, debrisColor, true);
+
+    if (!complete) {
+        std::cerr << "Error: " << path << " is truncated or misses a column" << std::endl;
+        return false;
+    }
+
+    // The cached bounds are derived from the columns above.
+    const std::size_t n = static_cast<std::size_t>(bodyCount);
+    for (auto* bound : {&loaded.minX, &loaded.minY, &loaded.maxX, &loaded.maxY}) {
+        bound->resize(n);
+    }
+    loaded.refreshAllBounds();
+
+    bodies = std::move(loaded);
+    debris.resize(debrisKind.size());
+    for (std::size_t i = 0; i < debris.size(); ++i) {
+        debris[i].kind = debrisKind[i];
+        debris[i].position = {debrisPosX[i], debrisPosY[i]};
+        debris[i].extent = {debrisExtX[i], debrisExtY[i]};
+        debris[i].color = debrisColor[i];
+    }
+    info = loadedInfo;
+    return true;
+}
+
+// Save `Object::bodies` and the debris of `Object::staticObjects` (baked records included, up to the cap).
+bool saveScene(const std::string& path, const SnapshotInfo& info) {
+    std::vector<Debris> debris;
+    Object::staticObjects.copyRecords(debris);
+    SnapshotInfo full = info;
+    full.debrisCapacity = Object::staticObjects.capacity();
+    full.debrisAdded = Object::staticObjects.totalAdded();
+    full.debrisEvicted = Object::staticObjects.totalEvicted();
+    return writeSnapshot(path, Object::bodies, debris, full);
+}
+
+// Replace `Object::bodies` and the debris pool with a snapshot.
+bool loadScene(const std::string& path, SnapshotInfo& info) {
+    std::vector<Debris> debris;
+    if (!readSnapshot(path, Object::bodies, debris, info)) {
+        return false;
+    }
+    Object::staticObjects.setCapacity(static_cast<std::size_t>(info.debrisCapacity));
+    Object::staticObjects.restore(debris, info.debrisAdded, info.debrisEvicted);
+    return true;
+}
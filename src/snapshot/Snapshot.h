@@ -0,0 +1,61 @@
+#ifndef SNAPSHOT_H  // Include guard to prevent multiple inclusions of this header file.
+#define SNAPSHOT_H  // Define the macro `SNAPSHOT_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>           // Include SFML vectors for the world size.
+#include "../world/BodyStore.h"        // Include the body store that is saved and restored.
+#include "../debris/DebrisPool.h"      // Include the `Debris` records that are saved and restored.
+#include <cstdint>                     // Include fixed-width integer types for the file layout.
+#include <string>                      // Include STL string for the file path.
+#include <vector>                      // Include STL vector for the debris records.
+
+// Binary scene snapshot.
+//
+// Layout (all integers and floats little-endian):
+//   header   "ENGNSNAP", u32 version, u32 header size, u64 step, f64 time, f32 world width, f32 world height,
+//            u64 body count, u64 debris count, u64 debris capacity, u64 debris added, u64 debris evicted,
+//            u32 column count, u32 reserved
+//   table    per column: u32 column id, u32 element size, u64 file offset
+//   columns  one array per attribute, every array 64-byte aligned
+//
+// Bodies and debris are stored as the same structure of arrays the engine works on, so loading maps the
+// file and copies each column into place with one `memcpy`; nothing is parsed. Readers look columns up by
+// id in the table and ignore ids they do not know, so new columns can be added without a version bump;
+// the version only changes when an existing column changes meaning.
+constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+
+// Identifier of each column in the table.
+enum class SnapshotColumn : std::uint32_t {
+    PosX = 1, PosY, VelX, VelY, AccX, AccY, Mass, InvMass, ExtX, ExtY, Scale,  // f32 per body.
+    Sleeping, StillFrames, Kind, Color,                                       // u8, u16, u8, RGBA per body.
+    DebrisKind = 64, DebrisPosX, DebrisPosY, DebrisExtX, DebrisExtY, DebrisColor  // Per piece of debris.
+};
+
+// Scene-wide values stored next to the columns.
+struct SnapshotInfo {
+    std::uint64_t step = 0;                  // Steps simulated when the snapshot was taken.
+    double time = 0.0;                       // Simulated seconds at that point.
+    sf::Vector2f worldSize{800.0f, 600.0f};  // World bounds.
+    std::uint64_t debrisCapacity = DebrisPool::DEFAULT_CAPACITY;  // Cap of the debris pool.
+    std::uint64_t debrisAdded = 0;           // Debris created since the start.
+    std::uint64_t debrisEvicted = 0;         // Debris dropped because of the cap.
+};
+
+// Write `bodies` and `debris` (oldest first) to `path`. The file is written under a temporary name, flushed
+// to disk and renamed over `path` once complete (then the directory is flushed too, on POSIX systems), so a
+// crash or power loss mid-write never leaves a truncated snapshot behind.
+// Returns false (and prints the reason) if the file cannot be written.
+bool writeSnapshot(const std::string& path, const BodyStore& bodies, const std::vector<Debris>& debris,
+                   const SnapshotInfo& info);
+
+// Map `path` and replace the contents of `bodies` and `debris` with the snapshot. Returns false (and prints
+// the reason) if the file is missing, truncated, of an unknown version or lacks a required column; the
+// outputs are left unchanged in that case.
+bool readSnapshot(const std::string& path, BodyStore& bodies, std::vector<Debris>& debris, SnapshotInfo& info);
+
+// Save the current scene (`Object::bodies` and `Object::staticObjects`) in the foreground.
+bool saveScene(const std::string& path, const SnapshotInfo& info);
+
+// Replace the current scene with a snapshot, including the debris pool and its counters.
+bool loadScene(const std::string& path, SnapshotInfo& info);
+
+#endif // SNAPSHOT_H  // End of the include guard.
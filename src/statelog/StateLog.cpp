@@ -0,0 +1,372 @@
+#include "StateLog.h"                // Include the header file for the state log.
+#include "../profile/Profiler.h"     // Include the stage instrumentation.
+#include <algorithm>                 // Include `std::min`.
+#include <cmath>                     // Include `std::lround`.
+#include <cstring>                   // Include `std::memcpy`.
+#include <iostream>                  // Include `std::cerr` for error reporting.
+
+namespace {
+
+constexpr char MAGIC[8] = {'E', 'N', 'G', 'N', 'S', 'L', 'O', 'G'};
+constexpr std::size_t HEADER_SIZE = 40;  // Bytes of the fixed header.
+
+// Little-endian encoding, whatever the host byte order.
+void putBytes(std::vector<unsigned char>& out, std::uint64_t value, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+void putU32(std::vector<unsigned char>& out, std::uint32_t value) { putBytes(out, value, 4); }
+void putF32(std::vector<unsigned char>& out, float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, 4);
+    putU32(out, bits);
+}
+void putColor(std::vector<unsigned char>& out, sf::Color color) {
+    out.push_back(color.r);
+    out.push_back(color.g);
+    out.push_back(color.b);
+    out.push_back(color.a);
+}
+
+// Unsigned LEB128: 7 bits per byte, high bit set while more bytes follow.
+void putVarint(std::vector<unsigned char>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+// Signed values interleaved (0, -1, 1, -2, ...) so small changes of either sign take one byte.
+void putSigned(std::vector<unsigned char>& out, std::int64_t value) {
+    putVarint(out, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+// Bounds-checked decoding of a payload; `ok` turns false on the first read past the end.
+struct PayloadReader {
+    const unsigned char* p;
+    const unsigned char* end;
+    bool ok = true;
+
+    std::uint64_t bytes(std::size_t size) {
+        if (static_cast<std::size_t>(end - p) < size) {
+            ok = false;
+            return 0;
+        }
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            value |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+        }
+        p += size;
+        return value;
+    }
+    std::uint8_t u8() { return static_cast<std::uint8_t>(bytes(1)); }
+    std::uint32_t u32() { return static_cast<std::uint32_t>(bytes(4)); }
+    std::uint64_t u64() { return bytes(8); }
+    float f32() {
+        const std::uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, 4);
+        return value;
+    }
+    double f64() {
+        const std::uint64_t bits = u64();
+        double value;
+        std::memcpy(&value, &bits, 8);
+        return value;
+    }
+    sf::Color color() {
+        const std::uint32_t rgba = u32();
+        return sf::Color(rgba & 0xFF, (rgba >> 8) & 0xFF, (rgba >> 16) & 0xFF, rgba >> 24);
+    }
+    ShapeKind kind() {
+        const std::uint8_t value = u8();
+        if (value > static_cast<std::uint8_t>(ShapeKind::Triangle)) ok = false;  // Corrupt: no such shape.
+        return ok ? static_cast<ShapeKind>(value) : ShapeKind::Square;
+    }
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (p == end) break;
+            const unsigned char byte = *p++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        ok = false;
+        return 0;
+    }
+    std::int64_t signedVarint() {
+        const std::uint64_t value = varint();
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+};
+
+// Position on the quantized grid of the log.
+std::int32_t quantize(float position) {
+    return static_cast<std::int32_t>(std::lround(position * STATE_LOG_QUANTUM));
+}
+
+// Resize the replayed bodies to `count`, keeping the first ones.
+void resizeBodies(ReplayState& state, std::size_t count) {
+    BodyStore& bodies = state.bodies;
+    if (count < bodies.size()) {
+        BodyStore kept;  // `BodyStore` has no removal: rebuild it from the bodies that remain.
+        for (std::size_t i = 0; i < count; ++i) {
+            kept.add(bodies.kind[i], {bodies.posX[i], bodies.posY[i]}, {bodies.extX[i], bodies.extY[i]},
+                     bodies.color[i]);
+        }
+        bodies = std::move(kept);
+    }
+    while (bodies.size() < count) {
+        bodies.add(ShapeKind::Square, {0.0f, 0.0f}, {0.0f, 0.0f}, sf::Color::Transparent);  // Restyled next.
+    }
+    state.x.resize(count, 0);
+    state.y.resize(count, 0);
+}
+
+}  // namespace
+
+StateRecorder::StateRecorder(const StateLogSettings& settings) : settings(settings) {}
+
+StateRecorder::~StateRecorder() {
+    close();
+}
+
+// Create the file and write the header.
+bool StateRecorder::open(sf::Vector2f worldSize, std::size_t debrisCapacity) {
+    file.open(settings.path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Error: Cannot write " << settings.path << std::endl;
+        return false;
+    }
+
+    std::vector<unsigned char> header(MAGIC, MAGIC + sizeof(MAGIC));
+    putU32(header, STATE_LOG_VERSION);
+    putU32(header, static_cast<std::uint32_t>(HEADER_SIZE));
+    putF32(header, worldSize.x);
+    putF32(header, worldSize.y);
+    std::uint64_t fpsBits;
+    std::memcpy(&fpsBits, &settings.fps, 8);
+    putBytes(header, fpsBits, 8);
+    putBytes(header, debrisCapacity, 8);
+    file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    bytes = header.size();
+    return static_cast<bool>(file);
+}
+
+// Collect new debris every call, and log a frame when one is due.
+void StateRecorder::update(float deltaTime, const BodyStore& bodies, const DebrisPool& debris) {
+    if (!file.is_open()) return;
+    collect(debris);
+
+    const double period = 1.0 / settings.fps;
+    clockTime += deltaTime;
+    while (clockTime >= period) {
+        clockTime -= period;
+        ++owed;  // Several frames may be owed after a long step; the state is shown for all of them.
+    }
+    if (owed > 0) {
+        write(bodies);
+        owed = 0;
+    }
+}
+
+// Copy the records added to the pool since the last call.
+void StateRecorder::collect(const DebrisPool& debris) {
+    const std::uint64_t added = debris.totalAdded();
+    if (added < debrisSeen) {  // The pool was reset (e.g. restored from a snapshot).
+        debrisSeen = added;
+        return;
+    }
+    // Records already evicted or baked away cannot be logged any more: count them, so a replay missing debris
+    // is explained instead of silently differing from the run.
+    const std::uint64_t created = added - debrisSeen;
+    const std::size_t fresh = static_cast<std::size_t>(std::min<std::uint64_t>(created, debris.size()));
+    if (created > fresh) {
+        if (missed == 0) {
+            std::cerr << "Warning: Debris left the pool before it could be logged; the replay will miss it." << std::endl;
+        }
+        missed += created - fresh;
+    }
+    for (std::size_t i = debris.size() - fresh; i < debris.size(); ++i) {
+        newDebris.push_back(debris[i]);
+    }
+    debrisSeen = added;
+}
+
+// Encode the changes since the last frame.
+void StateRecorder::write(const BodyStore& bodies) {
+    ENGN_PROFILE_SCOPE("state log");
+    const std::size_t n = bodies.size();
+    const std::size_t known = std::min(n, lastX.size());  // Bodies the reader already has.
+    lastX.resize(n, 0);
+    lastY.resize(n, 0);
+    lastKind.resize(n);
+    lastWidth.resize(n);
+    lastHeight.resize(n);
+    lastColor.resize(n);
+
+    buffer.assign(4, 0);  // Payload size, filled in once the frame is encoded.
+    putVarint(buffer, owed);
+    putVarint(buffer, n);
+
+    // Shapes, sizes and colors: only for new bodies and the few that shrank or changed.
+    restyled.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i >= known || bodies.kind[i] != lastKind[i] || bodies.extX[i] != lastWidth[i] ||
+            bodies.extY[i] != lastHeight[i] || bodies.color[i] != lastColor[i]) {
+            restyled.push_back(i);
+        }
+    }
+    putVarint(buffer, restyled.size());
+    std::size_t expected = 0;  // Index following the previous restyle.
+    for (std::size_t i : restyled) {
+        putVarint(buffer, i - expected);
+        expected = i + 1;
+        buffer.push_back(static_cast<unsigned char>(bodies.kind[i]));
+        putF32(buffer, bodies.extX[i]);
+        putF32(buffer, bodies.extY[i]);
+        putColor(buffer, bodies.color[i]);
+        lastKind[i] = bodies.kind[i];
+        lastWidth[i] = bodies.extX[i];
+        lastHeight[i] = bodies.extY[i];
+        lastColor[i] = bodies.color[i];
+    }
+
+    // Positions: the change since the last frame, on the quantized grid so rounding never drifts.
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::int32_t x = quantize(bodies.posX[i]);
+        const std::int32_t y = quantize(bodies.posY[i]);
+        putSigned(buffer, static_cast<std::int64_t>(x) - lastX[i]);
+        putSigned(buffer, static_cast<std::int64_t>(y) - lastY[i]);
+        lastX[i] = x;
+        lastY[i] = y;
+    }
+
+    putVarint(buffer, newDebris.size());
+    for (const Debris& piece : newDebris) {
+        buffer.push_back(static_cast<unsigned char>(piece.kind));
+        putF32(buffer, piece.position.x);
+        putF32(buffer, piece.position.y);
+        putF32(buffer, piece.extent.x);
+        putF32(buffer, piece.extent.y);
+        putColor(buffer, piece.color);
+    }
+    newDebris.clear();
+
+    const std::uint32_t payload = static_cast<std::uint32_t>(buffer.size() - 4);
+    for (std::size_t i = 0; i < 4; ++i) {
+        buffer[i] = static_cast<unsigned char>(payload >> (8 * i));
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    bytes += buffer.size();
+    ++frames;
+}
+
+// Flush the log.
+void StateRecorder::close() {
+    if (file.is_open()) {
+        file.close();
+        if (missed > 0) {
+            std::cerr << "Warning: " << missed << " debris pieces are missing from " << settings.path << std::endl;
+        }
+    }
+}
+
+// Read and check the header.
+bool StateLogReader::open(const std::string& path) {
+    file.open(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << std::endl;
+        return false;
+    }
+
+    unsigned char header[HEADER_SIZE];
+    file.read(reinterpret_cast<char*>(header), HEADER_SIZE);
+    if (file.gcount() != static_cast<std::streamsize>(HEADER_SIZE) || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Error: " << path << " is not a state log" << std::endl;
+        return false;
+    }
+    PayloadReader in{header + sizeof(MAGIC), header + HEADER_SIZE};
+    const std::uint32_t version = in.u32();
+    const std::uint32_t headerSize = in.u32();
+    if (version != STATE_LOG_VERSION || headerSize < HEADER_SIZE) {
+        std::cerr << "Error: " << path << " has unsupported version " << version << std::endl;
+        return false;
+    }
+    logHeader.worldSize.x = in.f32();
+    logHeader.worldSize.y = in.f32();
+    logHeader.fps = in.f64();
+    logHeader.debrisCapacity = in.u64();
+    file.seekg(headerSize);  // Fields appended by later versions are skipped.
+    return static_cast<bool>(file);
+}
+
+// Decode one frame on top of the previous state.
+bool StateLogReader::next(ReplayState& state) {
+    unsigned char size[4];
+    file.read(reinterpret_cast<char*>(size), 4);
+    if (file.gcount() != 4) return false;  // End of the log.
+    buffer.resize(PayloadReader{size, size + 4}.u32());
+    file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (file.gcount() != static_cast<std::streamsize>(buffer.size())) return false;  // Cut short by a crash.
+
+    PayloadReader in{buffer.data(), buffer.data() + buffer.size()};
+    state.repeat = static_cast<unsigned>(in.varint());
+    const std::uint64_t n = in.varint();
+    if (!in.ok || n > buffer.size()) return false;  // Every body takes at least 2 bytes.
+    resizeBodies(state, static_cast<std::size_t>(n));
+
+    BodyStore& bodies = state.bodies;
+    const std::uint64_t restyles = in.varint();
+    std::uint64_t expected = 0;
+    for (std::uint64_t r = 0; r < restyles && in.ok; ++r) {
+        const std::uint64_t i = expected + in.varint();
+        const ShapeKind kind = in.kind();
+        const float width = in.f32();
+        const float height = in.f32();
+        const sf::Color color = in.color();
+        if (i >= n) in.ok = false;
+        if (!in.ok) break;
+        bodies.kind[i] = kind;
+        bodies.extX[i] = width;
+        bodies.extY[i] = height;
+        bodies.color[i] = color;
+        expected = i + 1;
+    }
+
+    for (std::size_t i = 0; i < n && in.ok; ++i) {
+        state.x[i] += static_cast<std::int32_t>(in.signedVarint());
+        state.y[i] += static_cast<std::int32_t>(in.signedVarint());
+        bodies.posX[i] = state.x[i] / STATE_LOG_QUANTUM;
+        bodies.posY[i] = state.y[i] / STATE_LOG_QUANTUM;
+        bodies.refreshBounds(i);
+    }
+
+    const std::uint64_t debrisCount = in.varint();
+    state.newDebris.clear();
+    for (std::uint64_t d = 0; d < debrisCount && in.ok; ++d) {
+        Debris piece;
+        piece.kind = in.kind();
+        piece.position.x = in.f32();
+        piece.position.y = in.f32();
+        piece.extent.x = in.f32();
+        piece.extent.y = in.f32();
+        piece.color = in.color();
+        if (in.ok) state.newDebris.push_back(piece);
+    }
+
+    if (!in.ok) {
+        std::cerr << "Error: Corrupt frame in the state log, stopping there" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Continue reading at a frame boundary.
+bool StateLogReader::seek(std::uint64_t offset) {
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offset));
+    return static_cast<bool>(file);
+}
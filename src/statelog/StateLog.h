@@ -0,0 +1,124 @@
+#ifndef STATE_LOG_H  // Include guard to prevent multiple inclusions of this header file.
+#define STATE_LOG_H  // Define the macro `STATE_LOG_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>           // Include SFML vectors for the world size.
+#include "../world/BodyStore.h"        // Include the body store that is recorded and replayed.
+#include "../debris/DebrisPool.h"      // Include the debris whose creation is recorded.
+#include <cstdint>                     // Include fixed-width integer types for the file layout.
+#include <fstream>                     // Include file streams for the log file.
+#include <string>                      // Include STL string for the file path.
+#include <vector>                      // Include STL vector for the per-body state.
+
+// Compact log of a run, replayed offline into a video (see `replay/`).
+//
+// Layout (all integers and floats little-endian):
+//   header   "ENGNSLOG", u32 version, u32 header size, f32 world width, f32 world height, f64 frame rate,
+//            u64 debris capacity
+//   frames   u32 payload size, then the payload:
+//              varint repeat             video frames this state covers (more than one after a long step)
+//              varint body count
+//              varint restyle count      then per restyle: varint index gap, u8 kind, f32 width, f32 height,
+//                                        u32 RGBA; sent for new bodies and when a shape, size or color changes
+//              per body                  zigzag varint x and y, the change of the position in 1/16 units
+//              varint debris count       then per piece created since the last frame: u8 kind, f32 x, f32 y,
+//                                        f32 width, f32 height, u32 RGBA
+//
+// Positions are quantized and delta-encoded against the previous frame, so a resting body costs 2 bytes and a
+// moving one typically 3 to 5, instead of the width x height x 3 bytes of pixels an encoded frame starts from.
+// Debris is immovable, so only its creation is logged; the replay runs the same capped pool and evicts alike.
+// Debris evicted (or baked away) before the recorder collects it cannot be logged: it is counted in
+// `debrisMissed` and the replay lacks it, so call `update` at least as often as debris is drawn.
+constexpr std::uint32_t STATE_LOG_VERSION = 1;
+constexpr float STATE_LOG_QUANTUM = 16.0f;  // Position steps per world unit.
+
+// Values fixed for the whole log.
+struct StateLogHeader {
+    sf::Vector2f worldSize{800.0f, 600.0f};  // World bounds (the video covers them).
+    double fps = 30.0;                       // Video frame rate the states were sampled at.
+    std::uint64_t debrisCapacity = DebrisPool::DEFAULT_CAPACITY;  // Cap of the debris pool.
+};
+
+// Settings of a recording session.
+struct StateLogSettings {
+    std::string path = "output.slog";  // Output log file.
+    double fps = 30.0;                 // States are logged at this rate of elapsed time, as video frames would be.
+};
+
+// Writes the state log during a run. Costs a few bytes per body per logged frame and no rendering at all.
+class StateRecorder {
+public:
+    explicit StateRecorder(const StateLogSettings& settings);
+    ~StateRecorder();  // Closes the log.
+
+    StateRecorder(const StateRecorder&) = delete;
+    StateRecorder& operator=(const StateRecorder&) = delete;
+
+    // Create the log file and write its header. Returns false if the file cannot be opened.
+    bool open(sf::Vector2f worldSize, std::size_t debrisCapacity);
+
+    // Advance the log clock by `deltaTime` seconds and log the state if a frame is due. Call it every step
+    // or frame, before debris is drawn: it also collects the debris created since the last call, which
+    // baking releases once drawn.
+    void update(float deltaTime, const BodyStore& bodies, const DebrisPool& debris);
+
+    void close();  // Flush and close the log.
+
+    // Statistics.
+    std::uint64_t framesRecorded() const { return frames; }  // Frames logged (a repeated state counts once).
+    std::uint64_t bytesWritten() const { return bytes; }     // Size of the log so far.
+    std::uint64_t debrisMissed() const { return missed; }    // Debris gone from the pool before it was collected.
+
+private:
+    void collect(const DebrisPool& debris);  // Queue the debris created since the last call.
+    void write(const BodyStore& bodies);     // Encode and write one frame.
+
+    StateLogSettings settings;
+    std::ofstream file;
+    std::vector<unsigned char> buffer;       // Payload of the frame being written, reused between frames.
+
+    std::vector<std::int32_t> lastX, lastY;  // Quantized positions of the last frame.
+    std::vector<ShapeKind> lastKind;         // Shapes, sizes and colors of the last frame.
+    std::vector<float> lastWidth, lastHeight;
+    std::vector<sf::Color> lastColor;
+    std::vector<std::size_t> restyled;       // Bodies whose shape, size or color is sent this frame.
+    std::vector<Debris> newDebris;           // Debris created since the last frame.
+    std::uint64_t debrisSeen = 0;            // `DebrisPool::totalAdded` at the last collection.
+
+    double clockTime = 0.0;                  // Elapsed time accumulated since the last frame.
+    unsigned owed = 0;                       // Video frames due since the last frame.
+    std::uint64_t frames = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t missed = 0;
+};
+
+// State rebuilt from the log, frame after frame.
+struct ReplayState {
+    BodyStore bodies;                        // Positions, bounds, shapes, sizes and colors of the bodies.
+    std::vector<std::int32_t> x, y;          // Quantized positions the next frame's deltas apply to.
+    std::vector<Debris> newDebris;           // Debris created by the last frame, to add to the pool.
+    unsigned repeat = 1;                     // Video frames the last frame covers.
+};
+
+// Reads a state log one frame at a time.
+class StateLogReader {
+public:
+    // Open a log and read its header. Returns false (and prints the reason) if it is missing or of an
+    // unknown version.
+    bool open(const std::string& path);
+
+    const StateLogHeader& header() const { return logHeader; }
+
+    // Apply the next frame to `state`. Returns false at the end of the log; a frame cut short by a crash
+    // ends the log there.
+    bool next(ReplayState& state);
+
+    std::uint64_t tell() { return static_cast<std::uint64_t>(file.tellg()); }  // Offset of the next frame.
+    bool seek(std::uint64_t offset);  // Continue from an offset returned by `tell`.
+
+private:
+    std::ifstream file;
+    StateLogHeader logHeader;
+    std::vector<unsigned char> buffer;  // Payload of the frame being read, reused between frames.
+};
+
+#endif // STATE_LOG_H  // End of the include guard.
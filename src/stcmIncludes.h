@@ -6,5 +6,17 @@
 #include "obj/Square.h"       // Include the `Square` class, which represents square objects in the simulation.
 #include "obj/Triangle.h"     // Include the `Triangle` class, which represents triangular objects in the simulation.
 #include "obj/abs/object.h"   // Include the base `Object` class, which provides shared functionality for all objects.
+#include "world/broadphase/Broadphase.h"  // Include the broadphase interface used to find candidate collision pairs.
+#include "capture/FrameCapture.h"         // Include the asynchronous video capture pipeline.
+#include "sim/Simulation.h"               // Include the window-independent simulation step.
+#include "sim/HeadlessRunner.h"           // Include the headless batch mode.
+#include "sim/StepScheduler.h"            // Include the fixed-step scheduler of the windowed loop.
+#include "jobs/JobSystem.h"               // Include the work-stealing thread pool.
+#include "render/BodyRenderer.h"          // Include the batched renderer for the dynamic bodies.
+#include "profile/Profiler.h"             // Include the per-stage profiler (compiled out without `ENGN_PROFILING`).
+#include "render/ProfilerOverlay.h"       // Include the on-screen profiler panel.
+#include "snapshot/Snapshot.h"            // Include the binary scene snapshots.
+#include "snapshot/Checkpointer.h"        // Include the background checkpoint writer.
+#include "statelog/StateLog.h"            // Include the compact state log replayed by `Engn_replay`.
 
 #include <opencv2/opencv.hpp>  // Include OpenCV for video recording and image processing capabilities.
\ No newline at end of file
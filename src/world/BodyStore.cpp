@@ -0,0 +1,81 @@
+#include "BodyStore.h"  // Include the header file for the BodyStore class.
+
+// Add a new body with default physical state and return its id.
+std::size_t BodyStore::add(ShapeKind shapeKind, sf::Vector2f position, sf::Vector2f extent, sf::Color fillColor) {
+    std::size_t id = size();  // The new body is appended at the end of every column.
+
+    posX.push_back(position.x);
+    posY.push_back(position.y);
+    velX.push_back(0.0f);        // Bodies start at rest.
+    velY.push_back(0.0f);
+    accX.push_back(0.0f);        // Default acceleration corresponds to Earth's gravity.
+    accY.push_back(9.8f);
+    mass.push_back(1.0f);        // Default mass of 1.0.
+    invMass.push_back(1.0f);
+    extX.push_back(extent.x);
+    extY.push_back(extent.y);
+    scaleFactor.push_back(1.0f);
+    minX.push_back(0.0f);
+    minY.push_back(0.0f);
+    maxX.push_back(0.0f);
+    maxY.push_back(0.0f);
+    sleeping.push_back(0);       // Bodies start awake.
+    stillFrames.push_back(0);
+    kind.push_back(shapeKind);
+    color.push_back(fillColor);
+
+    refreshBounds(id);  // Initialize the cached bounding box.
+    return id;
+}
+
+// Remove every body.
+void BodyStore::clear() {
+    for (auto* column : {&posX, &posY, &velX, &velY, &accX, &accY, &mass, &invMass, &extX, &extY, &scaleFactor,
+                         &minX, &minY, &maxX, &maxY}) {
+        column->clear();
+    }
+    sleeping.clear();
+    stillFrames.clear();
+    kind.clear();
+    color.clear();
+}
+
+// Recompute the cached bounding boxes of all bodies.
+void BodyStore::refreshAllBounds() {
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        refreshBounds(i);
+    }
+}
+
+// Teleport a body to a new position.
+void BodyStore::setPosition(std::size_t id, sf::Vector2f position) {
+    posX[id] = position.x;
+    posY[id] = position.y;
+    refreshBounds(id);
+    wake(id);
+}
+
+// Offset a body by the given amount.
+void BodyStore::move(std::size_t id, sf::Vector2f offset, bool wakeUp) {
+    posX[id] += offset.x;
+    posY[id] += offset.y;
+    refreshBounds(id);
+    if (wakeUp) wake(id);
+}
+
+// Uniformly scale a body. Its origin is the top-left corner, so the position stays fixed.
+void BodyStore::scale(std::size_t id, float factor, bool wakeUp) {
+    scaleFactor[id] *= factor;
+    extX[id] *= factor;
+    extY[id] *= factor;
+    refreshBounds(id);
+    if (wakeUp) wake(id);
+}
+
+// Set a body's mass and keep its inverse in sync.
+void BodyStore::setMass(std::size_t id, float value) {
+    mass[id] = value;
+    invMass[id] = 1.0f / value;
+    wake(id);
+}
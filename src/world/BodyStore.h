@@ -0,0 +1,71 @@
+#ifndef BODY_STORE_H  // Include guard to prevent multiple inclusions of this header file.
+#define BODY_STORE_H  // Define the macro `BODY_STORE_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>  // Include SFML graphics library for vectors, rectangles and colors.
+#include "../obj/abs/enum/ShapeKind.h"  // Include the `ShapeKind` enum stored for every body.
+#include <vector>             // Include STL vector used for every structure-of-arrays column.
+#include <cstddef>            // Include `std::size_t` used for body ids.
+#include <cstdint>            // Include fixed-width integer types for the sleep columns.
+
+// Structure-of-arrays container that owns the physical state of every body in the simulation.
+// Each attribute lives in its own contiguous array indexed by body id, so passes that touch one
+// attribute of every body (integration, sorting, sweeping) stream linearly through memory instead
+// of chasing a pointer per object. The shape of a body is its `ShapeKind` plus its extent: code that depends
+// on it dispatches once on the kind (see `visitShape`) instead of calling through a polymorphic `sf::Shape`.
+class BodyStore {
+public:
+    // Add a new body and return its id. `extent` is the unscaled width/height of the shape's bounds.
+    std::size_t add(ShapeKind shapeKind, sf::Vector2f position, sf::Vector2f extent, sf::Color fillColor);
+
+    // Remove every body (ids restart at 0; existing handles become invalid).
+    void clear();
+
+    // Number of bodies currently stored.
+    std::size_t size() const { return posX.size(); }
+
+    // Recompute the cached bounding box of a body from its position and extent.
+    void refreshBounds(std::size_t id) {
+        minX[id] = posX[id];               // Left edge is the shape position (origin at top-left).
+        minY[id] = posY[id];               // Top edge.
+        maxX[id] = posX[id] + extX[id];    // Right edge.
+        maxY[id] = posY[id] + extY[id];    // Bottom edge.
+    }
+
+    // Recompute the cached bounding boxes of all bodies in a single linear pass.
+    void refreshAllBounds();
+
+    // Return the cached bounding box of a body as an SFML rectangle.
+    sf::FloatRect getBounds(std::size_t id) const {
+        return sf::FloatRect(minX[id], minY[id], maxX[id] - minX[id], maxY[id] - minY[id]);
+    }
+
+    // Sleep state. Sleeping bodies are skipped by integration and never paired with each other; any
+    // change made through the methods below wakes the body up, unless `wakeUp` is false.
+    bool isSleeping(std::size_t id) const { return sleeping[id] != 0; }
+    void wake(std::size_t id) {
+        sleeping[id] = 0;
+        stillFrames[id] = 0;
+    }
+
+    void setPosition(std::size_t id, sf::Vector2f position);  // Teleport a body and refresh its bounds.
+    void move(std::size_t id, sf::Vector2f offset, bool wakeUp = true);  // Offset a body and refresh its bounds.
+    void scale(std::size_t id, float factor, bool wakeUp = true);        // Uniformly scale a body's extent and shape.
+    void setMass(std::size_t id, float value);                // Set a body's mass and its precomputed inverse.
+
+    // Structure-of-arrays columns, indexed by body id. Public so batch kernels can iterate them directly.
+    std::vector<float> posX, posY;  // Top-left position of each body.
+    std::vector<float> velX, velY;  // Velocity of each body.
+    std::vector<float> accX, accY;  // Acceleration (force term) of each body.
+    std::vector<float> mass;        // Mass of each body.
+    std::vector<float> invMass;     // Precomputed 1 / mass, so integration multiplies instead of dividing.
+    std::vector<float> extX, extY;  // Current (scaled) width and height of each body.
+    std::vector<float> scaleFactor; // Accumulated uniform scale applied to the body.
+    std::vector<float> minX, minY;  // Cached bounding box: top-left corner.
+    std::vector<float> maxX, maxY;  // Cached bounding box: bottom-right corner.
+    std::vector<std::uint8_t> sleeping;     // 1 while the body is asleep.
+    std::vector<std::uint16_t> stillFrames; // Consecutive steps the body has been slower than the sleep threshold.
+    std::vector<ShapeKind> kind;    // Shape of each body.
+    std::vector<sf::Color> color;   // Fill color of each body.
+};
+
+#endif // BODY_STORE_H  // End of the include guard.
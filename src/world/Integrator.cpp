@@ -0,0 +1,220 @@
+#include "Integrator.h"  // Include the header file for the batch integrator.
+#include <cmath>         // Include `std::abs`.
+
+// The vector kernels are only built for x86 with GCC or Clang, which can target AVX2 per function
+// and detect the CPU features at runtime. Other compilers and architectures use the scalar kernel.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INTEGRATOR_HAS_X86_KERNELS 1
+#include <immintrin.h>  // Include SSE/AVX intrinsics.
+#endif
+
+namespace {
+
+// Raw pointers to the columns touched by the integrator.
+struct Columns {
+    float* posX; float* posY;
+    float* velX; float* velY;
+    const float* accX; const float* accY;
+    const float* invMass;
+    const float* extX; const float* extY;
+    float* minX; float* minY;
+    float* maxX; float* maxY;
+};
+
+Columns columnsOf(BodyStore& bodies) {
+    return {bodies.posX.data(), bodies.posY.data(), bodies.velX.data(), bodies.velY.data(),
+            bodies.accX.data(), bodies.accY.data(), bodies.invMass.data(),
+            bodies.extX.data(), bodies.extY.data(),
+            bodies.minX.data(), bodies.minY.data(), bodies.maxX.data(), bodies.maxY.data()};
+}
+
+// Scalar kernel, also used for the tail of the vector kernels.
+void integrateScalar(const Columns& c, std::size_t begin, std::size_t end, float dt, float worldW, float worldH) {
+    for (std::size_t i = begin; i < end; ++i) {
+        float scale = dt * c.invMass[i];
+        float vx = c.velX[i] + c.accX[i] * scale;  // Update velocity using acceleration and inverse mass.
+        float vy = c.velY[i] + c.accY[i] * scale;
+        float x = c.posX[i] + vx * dt;             // Move the body based on the updated velocity.
+        float y = c.posY[i] + vy * dt;
+        const float w = c.extX[i];
+        const float h = c.extY[i];
+
+        if (x <= 0.0f) { vx = std::abs(vx); x = 0.0f; }                 // Left boundary: bounce right.
+        if (x + w >= worldW) { vx = -std::abs(vx); x = worldW - w; }    // Right boundary: bounce left.
+        if (y <= 0.0f) { vy = std::abs(vy); y = 0.0f; }                 // Top boundary: bounce downward.
+        if (y + h >= worldH) { vy = -std::abs(vy); y = worldH - h; }    // Bottom boundary: bounce upward.
+
+        c.velX[i] = vx;
+        c.velY[i] = vy;
+        c.posX[i] = x;
+        c.posY[i] = y;
+        c.minX[i] = x;        // Refresh the cached bounding box.
+        c.minY[i] = y;
+        c.maxX[i] = x + w;
+        c.maxY[i] = y + h;
+    }
+}
+
+#ifdef INTEGRATOR_HAS_X86_KERNELS
+
+// SSE2 kernel: 4 bodies per iteration, branches replaced by masks.
+__attribute__((target("sse2")))
+void integrateSse(const Columns& c, std::size_t begin, std::size_t end, float dt, float worldW, float worldH) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 vw = _mm_set1_ps(worldW);
+    const __m128 vh = _mm_set1_ps(worldH);
+
+    // Select `a` where `mask` is set, `b` elsewhere.
+    auto select = [](__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 scale = _mm_mul_ps(vdt, _mm_loadu_ps(c.invMass + i));
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(c.velX + i), _mm_mul_ps(_mm_loadu_ps(c.accX + i), scale));
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(c.velY + i), _mm_mul_ps(_mm_loadu_ps(c.accY + i), scale));
+        __m128 x = _mm_add_ps(_mm_loadu_ps(c.posX + i), _mm_mul_ps(vx, vdt));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(c.posY + i), _mm_mul_ps(vy, vdt));
+        const __m128 w = _mm_loadu_ps(c.extX + i);
+        const __m128 h = _mm_loadu_ps(c.extY + i);
+
+        __m128 m = _mm_cmple_ps(x, zero);                                   // Left boundary.
+        vx = select(m, _mm_andnot_ps(signMask, vx), vx);
+        x = select(m, zero, x);
+        m = _mm_cmpge_ps(_mm_add_ps(x, w), vw);                             // Right boundary.
+        vx = select(m, _mm_or_ps(signMask, vx), vx);
+        x = select(m, _mm_sub_ps(vw, w), x);
+        m = _mm_cmple_ps(y, zero);                                          // Top boundary.
+        vy = select(m, _mm_andnot_ps(signMask, vy), vy);
+        y = select(m, zero, y);
+        m = _mm_cmpge_ps(_mm_add_ps(y, h), vh);                             // Bottom boundary.
+        vy = select(m, _mm_or_ps(signMask, vy), vy);
+        y = select(m, _mm_sub_ps(vh, h), y);
+
+        _mm_storeu_ps(c.velX + i, vx);
+        _mm_storeu_ps(c.velY + i, vy);
+        _mm_storeu_ps(c.posX + i, x);
+        _mm_storeu_ps(c.posY + i, y);
+        _mm_storeu_ps(c.minX + i, x);
+        _mm_storeu_ps(c.minY + i, y);
+        _mm_storeu_ps(c.maxX + i, _mm_add_ps(x, w));
+        _mm_storeu_ps(c.maxY + i, _mm_add_ps(y, h));
+    }
+    integrateScalar(c, i, end, dt, worldW, worldH);  // Remaining bodies.
+}
+
+// AVX2 kernel: 8 bodies per iteration, branches replaced by blends.
+__attribute__((target("avx2")))
+void integrateAvx2(const Columns& c, std::size_t begin, std::size_t end, float dt, float worldW, float worldH) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 vw = _mm256_set1_ps(worldW);
+    const __m256 vh = _mm256_set1_ps(worldH);
+
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 scale = _mm256_mul_ps(vdt, _mm256_loadu_ps(c.invMass + i));
+        __m256 vx = _mm256_add_ps(_mm256_loadu_ps(c.velX + i), _mm256_mul_ps(_mm256_loadu_ps(c.accX + i), scale));
+        __m256 vy = _mm256_add_ps(_mm256_loadu_ps(c.velY + i), _mm256_mul_ps(_mm256_loadu_ps(c.accY + i), scale));
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(c.posX + i), _mm256_mul_ps(vx, vdt));
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(c.posY + i), _mm256_mul_ps(vy, vdt));
+        const __m256 w = _mm256_loadu_ps(c.extX + i);
+        const __m256 h = _mm256_loadu_ps(c.extY + i);
+
+        __m256 m = _mm256_cmp_ps(x, zero, _CMP_LE_OQ);                                // Left boundary.
+        vx = _mm256_blendv_ps(vx, _mm256_andnot_ps(signMask, vx), m);
+        x = _mm256_blendv_ps(x, zero, m);
+        m = _mm256_cmp_ps(_mm256_add_ps(x, w), vw, _CMP_GE_OQ);                       // Right boundary.
+        vx = _mm256_blendv_ps(vx, _mm256_or_ps(signMask, vx), m);
+        x = _mm256_blendv_ps(x, _mm256_sub_ps(vw, w), m);
+        m = _mm256_cmp_ps(y, zero, _CMP_LE_OQ);                                       // Top boundary.
+        vy = _mm256_blendv_ps(vy, _mm256_andnot_ps(signMask, vy), m);
+        y = _mm256_blendv_ps(y, zero, m);
+        m = _mm256_cmp_ps(_mm256_add_ps(y, h), vh, _CMP_GE_OQ);                       // Bottom boundary.
+        vy = _mm256_blendv_ps(vy, _mm256_or_ps(signMask, vy), m);
+        y = _mm256_blendv_ps(y, _mm256_sub_ps(vh, h), m);
+
+        _mm256_storeu_ps(c.velX + i, vx);
+        _mm256_storeu_ps(c.velY + i, vy);
+        _mm256_storeu_ps(c.posX + i, x);
+        _mm256_storeu_ps(c.posY + i, y);
+        _mm256_storeu_ps(c.minX + i, x);
+        _mm256_storeu_ps(c.minY + i, y);
+        _mm256_storeu_ps(c.maxX + i, _mm256_add_ps(x, w));
+        _mm256_storeu_ps(c.maxY + i, _mm256_add_ps(y, h));
+    }
+    integrateScalar(c, i, end, dt, worldW, worldH);  // Remaining bodies.
+}
+
+#endif // INTEGRATOR_HAS_X86_KERNELS
+
+// Run the kernel of the requested instruction set over [begin, end).
+void integrateRun(const Columns& c, std::size_t begin, std::size_t end, float deltaTime,
+                  sf::Vector2f worldSize, SimdLevel level) {
+    switch (level) {
+#ifdef INTEGRATOR_HAS_X86_KERNELS
+        case SimdLevel::Avx2:
+            integrateAvx2(c, begin, end, deltaTime, worldSize.x, worldSize.y);
+            return;
+        case SimdLevel::Sse:
+            integrateSse(c, begin, end, deltaTime, worldSize.x, worldSize.y);
+            return;
+#endif
+        default:
+            integrateScalar(c, begin, end, deltaTime, worldSize.x, worldSize.y);
+            return;
+    }
+}
+
+} // namespace
+
+// Best instruction set supported by the CPU (detected once).
+SimdLevel detectSimdLevel() {
+#ifdef INTEGRATOR_HAS_X86_KERNELS
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+        if (__builtin_cpu_supports("sse2")) return SimdLevel::Sse;
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Human-readable name of an instruction set level.
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx2: return "avx2";
+        case SimdLevel::Sse: return "sse2";
+        case SimdLevel::Scalar:
+        default: return "scalar";
+    }
+}
+
+// Advance the awake bodies of [begin, end) with the requested instruction set.
+void integrateBodies(BodyStore& bodies, std::size_t begin, std::size_t end, float deltaTime,
+                     sf::Vector2f worldSize, SimdLevel level) {
+    const Columns c = columnsOf(bodies);
+    const std::uint8_t* sleeping = bodies.sleeping.data();
+
+    // The kernels run over each run of consecutive awake bodies; sleeping bodies are not touched at all.
+    std::size_t i = begin;
+    while (i < end) {
+        while (i < end && sleeping[i]) ++i;
+        std::size_t runEnd = i;
+        while (runEnd < end && !sleeping[runEnd]) ++runEnd;
+        if (runEnd > i) {
+            integrateRun(c, i, runEnd, deltaTime, worldSize, level);
+        }
+        i = runEnd;
+    }
+}
+
+// Advance every body with the best instruction set supported by the CPU.
+void integrateBodies(BodyStore& bodies, float deltaTime, sf::Vector2f worldSize) {
+    integrateBodies(bodies, 0, bodies.size(), deltaTime, worldSize, detectSimdLevel());
+}
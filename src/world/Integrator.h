@@ -0,0 +1,31 @@
+#ifndef INTEGRATOR_H  // Include guard to prevent multiple inclusions of this header file.
+#define INTEGRATOR_H  // Define the macro `INTEGRATOR_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>  // Include SFML graphics for vectors.
+#include "BodyStore.h"        // Include the store whose columns are integrated.
+#include <cstddef>            // Include `std::size_t`.
+
+// Instruction sets the batch integrator can use.
+enum class SimdLevel {
+    Scalar,  // Plain C++ loop, available everywhere.
+    Sse,     // 4 bodies per iteration (x86 SSE2).
+    Avx2     // 8 bodies per iteration (x86 AVX2).
+};
+
+// Best instruction set supported by the CPU running the program (detected once).
+SimdLevel detectSimdLevel();
+
+// Human-readable name of an instruction set level.
+const char* simdLevelName(SimdLevel level);
+
+// Advance the bodies [begin, end) of the store by `deltaTime` in a single pass:
+// velocity += acceleration * deltaTime / mass, position += velocity * deltaTime,
+// then bounce off the world bounds (0, 0)-`worldSize` and refresh the cached bounding boxes.
+// Sleeping bodies are skipped. All three kernels produce bit-identical results.
+void integrateBodies(BodyStore& bodies, std::size_t begin, std::size_t end, float deltaTime,
+                     sf::Vector2f worldSize, SimdLevel level);
+
+// Advance every body of the store with the best instruction set supported by the CPU.
+void integrateBodies(BodyStore& bodies, float deltaTime, sf::Vector2f worldSize);
+
+#endif // INTEGRATOR_H  // End of the include guard.
@@ -0,0 +1,14 @@
+#include "Broadphase.h"      // Include the broadphase interface.
+#include "SweepAndPrune.h"   // Include the sweep-and-prune backend.
+#include "SpatialHashGrid.h" // Include the uniform grid backend.
+
+// Create a broadphase of the given type with default settings.
+std::unique_ptr<Broadphase> createBroadphase(BroadphaseType type) {
+    switch (type) {
+        case BroadphaseType::SpatialHash:
+            return std::make_unique<SpatialHashGrid>();  // Cell size is derived from the bodies each frame.
+        case BroadphaseType::SweepAndPrune:
+        default:
+            return std::make_unique<SweepAndPrune>();  // Default to sweep-and-prune.
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef BROADPHASE_H  // Include guard to prevent multiple inclusions of this header file.
+#define BROADPHASE_H  // Define the macro `BROADPHASE_H` to ensure the file is included only once.
+
+#include "../BodyStore.h"  // Include the body store whose cached bounding boxes are tested.
+#include <vector>          // Include STL vector for the candidate pair list.
+#include <utility>         // Include `std::pair` for body pairs.
+#include <memory>          // Include `std::unique_ptr` returned by the factory.
+
+// A pair of body ids, always stored with the smaller id first.
+using BodyPair = std::pair<std::size_t, std::size_t>;
+
+// Available broadphase backends.
+enum class BroadphaseType {
+    SweepAndPrune,  // Persistent sort-and-sweep, best for coherent scenes with varying density.
+    SpatialHash     // Uniform hashed grid, best for scenes of uniform density and similar sizes.
+};
+
+// Interface of a broadphase: finds the pairs of bodies whose bounding boxes overlap,
+// so the narrowphase (`Object::checkCollision` / `Object::resolveCollision`) only sees those.
+class Broadphase {
+public:
+    virtual ~Broadphase() = default;
+
+    // Clear `pairs` and fill it with every pair of bodies whose cached bounding boxes overlap.
+    virtual void findPairs(const BodyStore& bodies, std::vector<BodyPair>& pairs) = 0;
+};
+
+// Create a broadphase of the given type with default settings.
+std::unique_ptr<Broadphase> createBroadphase(BroadphaseType type);
+
+#endif // BROADPHASE_H  // End of the include guard.
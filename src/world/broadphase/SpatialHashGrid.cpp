@@ -0,0 +1,91 @@
+#include "SpatialHashGrid.h"  // Include the header file for the SpatialHashGrid class.
+#include <algorithm>          // Include `std::max` and `std::min`.
+#include <cmath>              // Include `std::floor`.
+
+// Hash a cell coordinate into a bucket index (`mask` = bucket count - 1, a power of two minus one).
+static inline std::uint32_t hashCell(std::int32_t cx, std::int32_t cy, std::uint32_t mask) {
+    std::uint32_t h = static_cast<std::uint32_t>(cx) * 73856093u ^ static_cast<std::uint32_t>(cy) * 19349663u;
+    return h & mask;
+}
+
+// Insert every body into the grid and report the overlapping pairs found in each cell.
+void SpatialHashGrid::findPairs(const BodyStore& bodies, std::vector<BodyPair>& pairs) {
+    pairs.clear();
+    const std::size_t n = bodies.size();
+    if (n < 2) return;
+
+    // Automatic cell size: the largest extent, so most bodies touch at most four cells.
+    float cell = cellSize;
+    if (cell <= 0.0f) {
+        for (std::size_t i = 0; i < n; ++i) {
+            cell = std::max(cell, std::max(bodies.extX[i], bodies.extY[i]));
+        }
+        if (cell <= 0.0f) cell = 1.0f;
+    }
+    const float invCell = 1.0f / cell;
+
+    // Insert each body into every cell its bounding box touches.
+    entries.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        std::int32_t x0 = static_cast<std::int32_t>(std::floor(bodies.minX[i] * invCell));
+        std::int32_t y0 = static_cast<std::int32_t>(std::floor(bodies.minY[i] * invCell));
+        std::int32_t x1 = static_cast<std::int32_t>(std::floor(bodies.maxX[i] * invCell));
+        std::int32_t y1 = static_cast<std::int32_t>(std::floor(bodies.maxY[i] * invCell));
+        for (std::int32_t cy = y0; cy <= y1; ++cy) {
+            for (std::int32_t cx = x0; cx <= x1; ++cx) {
+                entries.push_back({cx, cy, static_cast<std::uint32_t>(i)});
+            }
+        }
+    }
+
+    // Bucket count: next power of two at least twice the number of entries, to keep collisions rare.
+    std::uint32_t buckets = 1;
+    while (buckets < 2 * entries.size()) buckets <<= 1;
+    const std::uint32_t mask = buckets - 1;
+
+    // Counting sort of the entries by bucket.
+    bucketStart.assign(buckets + 1, 0);
+    for (const Entry& e : entries) {
+        ++bucketStart[hashCell(e.cx, e.cy, mask) + 1];
+    }
+    for (std::uint32_t b = 0; b < buckets; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    sorted.resize(entries.size());
+    for (const Entry& e : entries) {
+        sorted[bucketStart[hashCell(e.cx, e.cy, mask)]++] = e;  // `bucketStart[b]` now ends at the start of bucket b + 1.
+    }
+    for (std::uint32_t b = buckets; b > 0; --b) {
+        bucketStart[b] = bucketStart[b - 1];  // Shift back so `bucketStart[b]` is the start of bucket b again.
+    }
+    bucketStart[0] = 0;
+
+    // Test the bodies sharing each cell.
+    for (std::uint32_t b = 0; b < buckets; ++b) {
+        const std::uint32_t begin = bucketStart[b];
+        const std::uint32_t end = bucketStart[b + 1];
+        for (std::uint32_t i = begin; i < end; ++i) {
+            const Entry& ea = sorted[i];
+            const std::size_t a = ea.body;
+            for (std::uint32_t j = i + 1; j < end; ++j) {
+                const Entry& eb = sorted[j];
+                if (eb.cx != ea.cx || eb.cy != ea.cy) continue;  // Different cell hashed into the same bucket.
+
+                const std::size_t c = eb.body;
+                if (bodies.sleeping[a] & bodies.sleeping[c]) continue;  // Two sleeping bodies cannot start colliding.
+                if (!(bodies.minX[a] < bodies.maxX[c] && bodies.minX[c] < bodies.maxX[a] &&
+                      bodies.minY[a] < bodies.maxY[c] && bodies.minY[c] < bodies.maxY[a])) {
+                    continue;  // Bounding boxes do not overlap.
+                }
+
+                // A pair shares several cells when both bodies span them; report it only from the cell
+                // containing the top-left corner of the overlap so each pair is emitted exactly once.
+                std::int32_t ox = static_cast<std::int32_t>(std::floor(std::max(bodies.minX[a], bodies.minX[c]) * invCell));
+                std::int32_t oy = static_cast<std::int32_t>(std::floor(std::max(bodies.minY[a], bodies.minY[c]) * invCell));
+                if (ox != ea.cx || oy != ea.cy) continue;
+
+                pairs.emplace_back(std::min(a, c), std::max(a, c));
+            }
+        }
+    }
+}
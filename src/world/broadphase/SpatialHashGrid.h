@@ -0,0 +1,31 @@
+#ifndef SPATIAL_HASH_GRID_H  // Include guard to prevent multiple inclusions of this header file.
+#define SPATIAL_HASH_GRID_H  // Define the macro `SPATIAL_HASH_GRID_H` to ensure the file is included only once.
+
+#include "Broadphase.h"  // Include the broadphase interface.
+#include <cstdint>       // Include fixed-width integer types for cell coordinates and hashes.
+
+// Uniform-grid broadphase backed by a spatial hash.
+// Every body is inserted into each cell its bounding box touches; only bodies sharing a cell are
+// tested against each other. Buckets are laid out contiguously (counting sort) and all buffers are
+// reused between frames. Works best when bodies have similar sizes and are spread evenly.
+class SpatialHashGrid : public Broadphase {
+public:
+    // `cellSize` <= 0 derives the cell size from the largest body extent every frame.
+    explicit SpatialHashGrid(float cellSize = 0.0f) : cellSize(cellSize) {}
+
+    void findPairs(const BodyStore& bodies, std::vector<BodyPair>& pairs) override;
+
+private:
+    // One body inserted into one cell.
+    struct Entry {
+        std::int32_t cx, cy;  // Cell coordinates.
+        std::uint32_t body;   // Body id.
+    };
+
+    float cellSize;                       // Requested cell size (0 = automatic).
+    std::vector<Entry> entries;           // Cell entries of this frame, unordered.
+    std::vector<Entry> sorted;            // Cell entries grouped by bucket.
+    std::vector<std::uint32_t> bucketStart;  // Start offset of each bucket in `sorted` (size = buckets + 1).
+};
+
+#endif // SPATIAL_HASH_GRID_H  // End of the include guard.
@@ -0,0 +1,97 @@
+#include "SweepAndPrune.h"  // Include the header file for the SweepAndPrune class.
+#include <algorithm>        // Include `std::sort` used when the sweep axis changes.
+
+// Only switch axes when the other one is clearly better, so the persistent order is not thrown away every frame.
+static constexpr float AXIS_SWITCH_HYSTERESIS = 1.5f;
+
+// Pick the axis along which the bounding box centers have the largest variance.
+bool SweepAndPrune::chooseAxisX(const BodyStore& bodies) const {
+    const std::size_t n = bodies.size();
+    if (n < 2) return axisX;  // Nothing to compare, keep the current axis.
+
+    double sumX = 0.0, sumY = 0.0, sumX2 = 0.0, sumY2 = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        double cx = 0.5 * (bodies.minX[i] + bodies.maxX[i]);  // Center of the bounding box.
+        double cy = 0.5 * (bodies.minY[i] + bodies.maxY[i]);
+        sumX += cx;
+        sumY += cy;
+        sumX2 += cx * cx;
+        sumY2 += cy * cy;
+    }
+    double varX = sumX2 - sumX * sumX / n;  // Variances scaled by n (the common factor does not matter).
+    double varY = sumY2 - sumY * sumY / n;
+
+    if (axisX) {
+        return !(varY > varX * AXIS_SWITCH_HYSTERESIS);  // Stay on X unless Y is clearly more spread out.
+    }
+    return varX > varY * AXIS_SWITCH_HYSTERESIS;  // Stay on Y unless X is clearly more spread out.
+}
+
+// Repair the persistent order and sweep it for overlapping pairs.
+void SweepAndPrune::findPairs(const BodyStore& bodies, std::vector<BodyPair>& pairs) {
+    pairs.clear();
+    const std::size_t n = bodies.size();
+
+    // Start over if bodies were removed; append bodies created since the last frame.
+    if (order.size() > n) {
+        order.clear();
+    }
+    // Insertion sort is only cheap for a nearly sorted list: sort from scratch when many bodies are new.
+    bool fullSort = (n - order.size()) * 8 > n;
+    for (std::size_t id = order.size(); id < n; ++id) {
+        order.push_back(id);
+    }
+    keys.resize(n);
+
+    bool useX = chooseAxisX(bodies);
+    const std::vector<float>& lo = useX ? bodies.minX : bodies.minY;       // Lower edges on the sweep axis.
+    const std::vector<float>& hi = useX ? bodies.maxX : bodies.maxY;       // Upper edges on the sweep axis.
+    const std::vector<float>& otherLo = useX ? bodies.minY : bodies.minX;  // Lower edges on the other axis.
+    const std::vector<float>& otherHi = useX ? bodies.maxY : bodies.maxX;  // Upper edges on the other axis.
+
+    // The previous order was for the other axis and may be far from sorted: sort from scratch once.
+    if (useX != axisX) {
+        axisX = useX;
+        fullSort = true;
+    }
+
+    if (fullSort) {
+        std::sort(order.begin(), order.end(), [&lo](std::size_t a, std::size_t b) { return lo[a] < lo[b]; });
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = lo[order[i]];
+        }
+    } else {
+        // Refresh the sort keys from the store, in the persistent order.
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = lo[order[i]];
+        }
+        // Insertion sort: nearly linear when bodies moved little since the previous frame.
+        for (std::size_t i = 1; i < n; ++i) {
+            float key = keys[i];
+            std::size_t id = order[i];
+            std::size_t j = i;
+            while (j > 0 && keys[j - 1] > key) {
+                keys[j] = keys[j - 1];
+                order[j] = order[j - 1];
+                --j;
+            }
+            keys[j] = key;
+            order[j] = id;
+        }
+    }
+
+    // Sweep: each body is only tested against the bodies that start before it ends on the sweep axis.
+    // Two sleeping bodies cannot start colliding, so their pairs are not reported.
+    const std::vector<std::uint8_t>& sleeping = bodies.sleeping;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t a = order[i];
+        float end = hi[a];
+        for (std::size_t j = i + 1; j < n && keys[j] < end; ++j) {
+            std::size_t b = order[j];
+            if (sleeping[a] & sleeping[b]) continue;
+            if (otherLo[a] < otherHi[b] && otherLo[b] < otherHi[a]) {  // Overlap on the other axis too.
+                pairs.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef SWEEP_AND_PRUNE_H  // Include guard to prevent multiple inclusions of this header file.
+#define SWEEP_AND_PRUNE_H  // Define the macro `SWEEP_AND_PRUNE_H` to ensure the file is included only once.
+
+#include "Broadphase.h"  // Include the broadphase interface.
+
+// Persistent sweep-and-prune broadphase.
+// Bodies are kept sorted by the lower edge of their bounding box along one axis between frames.
+// Each frame the list is repaired with an insertion sort, which is close to O(n) when bodies move
+// little from frame to frame, then swept once: a body is only tested against the following bodies
+// whose lower edge starts before its upper edge. The sweep axis follows the axis along which the
+// bodies are most spread out, so tall columns of bodies are swept vertically instead of degrading to O(n²).
+class SweepAndPrune : public Broadphase {
+public:
+    void findPairs(const BodyStore& bodies, std::vector<BodyPair>& pairs) override;
+
+private:
+    // Pick the axis along which the bounding box centers have the largest variance.
+    bool chooseAxisX(const BodyStore& bodies) const;
+
+    std::vector<std::size_t> order;  // Body ids sorted by their lower edge on the sweep axis (kept between frames).
+    std::vector<float> keys;         // Lower edge of `order[i]`, kept next to it so the sort scans contiguous memory.
+    bool axisX = true;               // Current sweep axis (true = X, false = Y).
+};
+
+#endif // SWEEP_AND_PRUNE_H  // End of the include guard.
@@ -0,0 +1,328 @@
+#include "BarnesHut.h"                  // Include the header file for the Barnes–Hut gravity.
+#include "../../profile/Profiler.h"     // Include the stage instrumentation.
+#include <algorithm>                    // Include `std::min`, `std::max`, `std::lower_bound`, `std::partition_point`.
+#include <cmath>                        // Include `std::sqrt`.
+#include <functional>                   // Include `std::function` for the serial fallback.
+#include <limits>                       // Include the float limits used to seed the bounds.
+
+static constexpr unsigned MAX_DEPTH = 16;        // Levels of the tree; Morton keys hold 16 bits per axis.
+static constexpr unsigned TOP_DEPTH = 3;         // Cells at this depth (4^3 = 64) are built as parallel subtrees.
+static constexpr unsigned TOP_CELLS = 1u << (2 * TOP_DEPTH);
+static constexpr std::uint32_t LEAF_SIZE = 8;    // Cells with at most this many bodies are not split.
+static constexpr std::size_t SORT_GRAIN = 16384; // Bodies per radix sort chunk.
+static constexpr std::size_t EVAL_GRAIN = 64;    // Leaves per force evaluation job.
+static constexpr std::uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+// Run `body` over [0, count) in chunks of exactly `grain` elements (the last one may be shorter), on the
+// pool or inline without one. Chunks always start at multiples of `grain`, so `begin / grain` indexes
+// per-chunk scratch data even when the pool runs a whole loop inline.
+static void forRange(JobSystem* jobs, std::size_t count, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& body) {
+    auto chunked = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t chunk = begin; chunk < end; chunk += grain) {
+            body(chunk, std::min(end, chunk + grain));
+        }
+    };
+    if (jobs) {
+        jobs->parallelFor(count, grain, chunked);
+    } else {
+        chunked(0, count);
+    }
+}
+
+// Spread the 16 low bits of `v` over the even bits of the result.
+static std::uint32_t spreadBits(std::uint32_t v) {
+    v &= 0xFFFFu;
+    v = (v | (v << 8)) & 0x00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+// Add the mutual gravity of the bodies to their velocities.
+void BarnesHutGravity::apply(BodyStore& bodies, float deltaTime, JobSystem* jobs) {
+    if (bodies.size() < 2) return;
+    {
+        ENGN_PROFILE_SCOPE("gravity_build");
+        sortBodies(bodies, jobs);
+        buildTree(jobs);
+    }
+    ENGN_PROFILE_SCOPE("gravity_eval");
+    evaluate(bodies, deltaTime, jobs);
+}
+
+// Compute the Morton key of every body centre and sort them with a parallel LSD radix sort.
+void BarnesHutGravity::sortBodies(const BodyStore& bodies, JobSystem* jobs) {
+    const std::size_t n = bodies.size();
+    const std::size_t chunks = (n + SORT_GRAIN - 1) / SORT_GRAIN;
+    keys.resize(n); keysTmp.resize(n);
+    order.resize(n); orderTmp.resize(n);
+    sortedX.resize(n); sortedY.resize(n); sortedMass.resize(n);
+
+    // Bounds of the body centres, reduced per chunk first.
+    bounds.resize(chunks * 4);
+    forRange(jobs, n, SORT_GRAIN, [&](std::size_t begin, std::size_t end) {
+        float lo[2] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        float hi[2] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+        for (std::size_t i = begin; i < end; ++i) {
+            const float cx = bodies.posX[i] + 0.5f * bodies.extX[i];
+            const float cy = bodies.posY[i] + 0.5f * bodies.extY[i];
+            lo[0] = std::min(lo[0], cx); hi[0] = std::max(hi[0], cx);
+            lo[1] = std::min(lo[1], cy); hi[1] = std::max(hi[1], cy);
+        }
+        float* out = &bounds[begin / SORT_GRAIN * 4];
+        out[0] = lo[0]; out[1] = lo[1]; out[2] = hi[0]; out[3] = hi[1];
+    });
+    float minX = bounds[0], minY = bounds[1], maxX = bounds[2], maxY = bounds[3];
+    for (std::size_t c = 1; c < chunks; ++c) {
+        minX = std::min(minX, bounds[c * 4]); minY = std::min(minY, bounds[c * 4 + 1]);
+        maxX = std::max(maxX, bounds[c * 4 + 2]); maxY = std::max(maxY, bounds[c * 4 + 3]);
+    }
+    rootX = minX;
+    rootY = minY;
+    rootSize = std::max(std::max(maxX - minX, maxY - minY), 1e-3f) * 1.0001f;  // Keep the far edge inside the last cell.
+
+    // Morton keys: 16 bits per axis, x on the even bits.
+    const float toCell = 65536.0f / rootSize;
+    forRange(jobs, n, SORT_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const float cx = bodies.posX[i] + 0.5f * bodies.extX[i];
+            const float cy = bodies.posY[i] + 0.5f * bodies.extY[i];
+            const std::uint32_t qx = std::min(65535u, static_cast<std::uint32_t>((cx - rootX) * toCell));
+            const std::uint32_t qy = std::min(65535u, static_cast<std::uint32_t>((cy - rootY) * toCell));
+            keys[i] = spreadBits(qx) | (spreadBits(qy) << 1);
+            order[i] = static_cast<std::uint32_t>(i);
+        }
+    });
+
+    // Radix sort, 8 bits per pass. Each chunk counts its digits, a prefix sum over (digit, chunk) gives every
+    // chunk its own output offsets, and the chunks scatter in parallel; the sort stays stable.
+    histograms.resize(chunks * 256);
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+        forRange(jobs, n, SORT_GRAIN, [&](std::size_t begin, std::size_t end) {
+            std::uint32_t* histogram = &histograms[begin / SORT_GRAIN * 256];
+            std::fill(histogram, histogram + 256, 0u);
+            for (std::size_t i = begin; i < end; ++i) {
+                ++histogram[(keys[i] >> shift) & 0xFFu];
+            }
+        });
+
+        std::uint32_t running = 0;
+        bool trivial = false;  // All keys share this digit: the pass would not move anything.
+        for (unsigned digit = 0; digit < 256; ++digit) {
+            std::uint32_t total = 0;
+            for (std::size_t c = 0; c < chunks; ++c) {
+                const std::uint32_t count = histograms[c * 256 + digit];
+                histograms[c * 256 + digit] = running;
+                running += count;
+                total += count;
+            }
+            trivial = trivial || total == n;
+        }
+        if (trivial) continue;
+
+        forRange(jobs, n, SORT_GRAIN, [&](std::size_t begin, std::size_t end) {
+            std::uint32_t* offset = &histograms[begin / SORT_GRAIN * 256];
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::uint32_t position = offset[(keys[i] >> shift) & 0xFFu]++;
+                keysTmp[position] = keys[i];
+                orderTmp[position] = order[i];
+            }
+        });
+        keys.swap(keysTmp);
+        order.swap(orderTmp);
+    }
+
+    // Gather the centres and masses in sorted order so the tree walk reads them sequentially.
+    forRange(jobs, n, SORT_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t j = begin; j < end; ++j) {
+            const std::uint32_t id = order[j];
+            sortedX[j] = bodies.posX[id] + 0.5f * bodies.extX[id];
+            sortedY[j] = bodies.posY[id] + 0.5f * bodies.extY[id];
+            sortedMass[j] = bodies.mass[id];
+        }
+    });
+}
+
+// Build the cell in `out[slot]` covering the sorted bodies [begin, end), then its children.
+// At `stopDepth` the cell is taken from the prebuilt subtree instead.
+void BarnesHutGravity::buildNode(std::vector<Node>& out, std::uint32_t slot, std::uint32_t begin, std::uint32_t end,
+                                 unsigned depth, float size, unsigned stopDepth) {
+    if (depth == stopDepth) {
+        const std::uint32_t cell = keys[begin] >> (32 - 2 * TOP_DEPTH);
+        out[slot] = subtrees[cell][0];  // Mass and centre are final; the child link is fixed when stitching.
+        subtreeSlot[cell] = slot;
+        return;
+    }
+
+    Node node{0.0f, 0.0f, 0.0f, size, begin, end, 0, 0};
+    if (end - begin <= LEAF_SIZE || depth == MAX_DEPTH) {
+        for (std::uint32_t k = begin; k < end; ++k) {
+            node.mass += sortedMass[k];
+            node.comX += sortedMass[k] * sortedX[k];
+            node.comY += sortedMass[k] * sortedY[k];
+        }
+    } else {
+        // Sorted keys group the four quadrants: split the range on the next two bits.
+        const unsigned shift = 2 * (MAX_DEPTH - 1 - depth);
+        std::uint32_t split[5] = {begin, 0, 0, 0, end};
+        for (unsigned q = 1; q < 4; ++q) {
+            split[q] = static_cast<std::uint32_t>(std::partition_point(keys.begin() + split[q - 1], keys.begin() + end,
+                [&](std::uint32_t key) { return ((key >> shift) & 3u) < q; }) - keys.begin());
+        }
+        for (unsigned q = 0; q < 4; ++q) {
+            node.childCount += split[q] < split[q + 1];
+        }
+
+        node.child = static_cast<std::uint32_t>(out.size());
+        out.resize(out.size() + node.childCount);  // Children are contiguous.
+        std::uint32_t next = node.child;
+        for (unsigned q = 0; q < 4; ++q) {
+            if (split[q] == split[q + 1]) continue;
+            buildNode(out, next, split[q], split[q + 1], depth + 1, size * 0.5f, stopDepth);
+            const Node& child = out[next++];
+            node.mass += child.mass;
+            node.comX += child.mass * child.comX;
+            node.comY += child.mass * child.comY;
+        }
+    }
+
+    if (node.mass > 0.0f) {
+        node.comX /= node.mass;
+        node.comY /= node.mass;
+    } else {
+        node.comX = sortedX[begin];  // Massless bodies: any point of the cell will do.
+        node.comY = sortedY[begin];
+    }
+    out[slot] = node;
+}
+
+// Build the subtrees of the top cells in parallel, the levels above them serially, then stitch.
+void BarnesHutGravity::buildTree(JobSystem* jobs) {
+    const std::uint32_t n = static_cast<std::uint32_t>(keys.size());
+
+    std::uint32_t cellStart[TOP_CELLS + 1];
+    for (std::uint32_t c = 0; c < TOP_CELLS; ++c) {
+        cellStart[c] = static_cast<std::uint32_t>(
+            std::lower_bound(keys.begin(), keys.end(), c << (32 - 2 * TOP_DEPTH)) - keys.begin());
+    }
+    cellStart[TOP_CELLS] = n;
+
+    subtrees.resize(TOP_CELLS);
+    subtreeSlot.assign(TOP_CELLS, NO_SLOT);
+    subtreeOffset.assign(TOP_CELLS, 0);
+    const float topSize = rootSize / (1u << TOP_DEPTH);
+    forRange(jobs, TOP_CELLS, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            subtrees[c].clear();  // Keeps the capacity of the previous step.
+            if (cellStart[c] == cellStart[c + 1]) continue;
+            subtrees[c].resize(1);
+            buildNode(subtrees[c], 0, cellStart[c], cellStart[c + 1], TOP_DEPTH, topSize, MAX_DEPTH + 1);
+        }
+    });
+
+    nodes.resize(1);
+    buildNode(nodes, 0, 0, n, 0, rootSize, TOP_DEPTH);
+
+    // Every used subtree except its root (already in its slot) goes after the top levels.
+    std::uint32_t total = static_cast<std::uint32_t>(nodes.size());
+    for (std::uint32_t c = 0; c < TOP_CELLS; ++c) {
+        if (subtreeSlot[c] == NO_SLOT) continue;
+        subtreeOffset[c] = total;
+        total += static_cast<std::uint32_t>(subtrees[c].size()) - 1;
+        if (nodes[subtreeSlot[c]].childCount > 0) {
+            nodes[subtreeSlot[c]].child += subtreeOffset[c] - 1;
+        }
+    }
+    nodes.resize(total);
+    forRange(jobs, TOP_CELLS, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            if (subtreeSlot[c] == NO_SLOT) continue;
+            const std::uint32_t offset = subtreeOffset[c];
+            for (std::size_t k = 1; k < subtrees[c].size(); ++k) {
+                Node node = subtrees[c][k];
+                if (node.childCount > 0) node.child += offset - 1;  // Local index k lands at offset + k - 1.
+                nodes[offset + k - 1] = node;
+            }
+        }
+    });
+}
+
+// Walk the tree once per leaf and share the result between the bodies of the leaf: the cells far enough
+// from the whole leaf go into one interaction list, the bodies of close leaves into another, and every
+// body of the leaf then sums both lists. This divides the tree walks by the leaf size.
+void BarnesHutGravity::evaluate(BodyStore& bodies, float deltaTime, JobSystem* jobs) {
+    leaves.clear();
+    for (std::uint32_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].childCount == 0) leaves.push_back(i);
+    }
+
+    const float g = settings.gravityConstant;
+    const float theta2 = settings.theta * settings.theta;
+    const float eps2 = settings.softening * settings.softening;
+
+    forRange(jobs, leaves.size(), EVAL_GRAIN, [&](std::size_t begin, std::size_t end) {
+        std::uint32_t stack[4 * MAX_DEPTH + 4];  // At most 3 pending siblings per level plus the last children.
+        // Interaction lists, kept per thread across jobs and steps so they stop allocating once grown.
+        static thread_local std::vector<float> far;          // Cells used as a whole: x, y, mass.
+        static thread_local std::vector<std::uint32_t> near; // Sorted bodies of the close leaves, summed one by one.
+
+        for (std::size_t l = begin; l < end; ++l) {
+            const Node& leaf = nodes[leaves[l]];
+
+            // Bounding box of the leaf's bodies: a cell may stand in only if it is far from all of them.
+            float minX = sortedX[leaf.begin], maxX = minX, minY = sortedY[leaf.begin], maxY = minY;
+            for (std::uint32_t k = leaf.begin + 1; k < leaf.end; ++k) {
+                minX = std::min(minX, sortedX[k]); maxX = std::max(maxX, sortedX[k]);
+                minY = std::min(minY, sortedY[k]); maxY = std::max(maxY, sortedY[k]);
+            }
+
+            far.clear();
+            near.clear();
+            std::size_t top = 0;
+            stack[top++] = 0;
+            while (top > 0) {
+                const std::uint32_t index = stack[--top];
+                const Node& node = nodes[index];
+                if (&node == &leaf) continue;  // Pairs inside the leaf are summed directly below.
+
+                const bool contains = node.begin <= leaf.begin && leaf.end <= node.end;
+                const float dx = std::max(std::max(minX - node.comX, node.comX - maxX), 0.0f);  // Gap to the box.
+                const float dy = std::max(std::max(minY - node.comY, node.comY - maxY), 0.0f);
+                if (!contains && node.size * node.size < theta2 * (dx * dx + dy * dy)) {
+                    far.insert(far.end(), {node.comX, node.comY, node.mass});  // Far enough: use the centre of mass.
+                } else if (node.childCount > 0) {
+                    for (std::uint32_t c = 0; c < node.childCount; ++c) {
+                        stack[top++] = node.child + c;  // Too close: open the cell.
+                    }
+                } else {
+                    for (std::uint32_t k = node.begin; k < node.end; ++k) near.push_back(k);  // Close leaf.
+                }
+            }
+
+            for (std::uint32_t j = leaf.begin; j < leaf.end; ++j) {
+                const float px = sortedX[j];
+                const float py = sortedY[j];
+                float ax = 0.0f, ay = 0.0f;
+                auto attract = [&](float x, float y, float mass) {
+                    const float ddx = x - px;
+                    const float ddy = y - py;
+                    const float inv = 1.0f / std::sqrt(ddx * ddx + ddy * ddy + eps2);
+                    const float f = g * mass * inv * inv * inv;
+                    ax += f * ddx;
+                    ay += f * ddy;
+                };
+                for (std::size_t f = 0; f < far.size(); f += 3) attract(far[f], far[f + 1], far[f + 2]);
+                for (std::uint32_t k : near) attract(sortedX[k], sortedY[k], sortedMass[k]);
+                for (std::uint32_t k = leaf.begin; k < leaf.end; ++k) {
+                    if (k != j) attract(sortedX[k], sortedY[k], sortedMass[k]);
+                }
+
+                const std::uint32_t id = order[j];
+                bodies.velX[id] += ax * deltaTime;
+                bodies.velY[id] += ay * deltaTime;
+            }
+        }
+    });
+}
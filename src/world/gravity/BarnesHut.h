@@ -0,0 +1,67 @@
+#ifndef BARNES_HUT_H  // Include guard to prevent multiple inclusions of this header file.
+#define BARNES_HUT_H  // Define the macro `BARNES_HUT_H` to ensure the file is included only once.
+
+#include "../BodyStore.h"          // Include the store whose bodies attract each other.
+#include "../../jobs/JobSystem.h"  // Include the thread pool the build and evaluation run on.
+#include <cstddef>                 // Include `std::size_t`.
+#include <cstdint>                 // Include fixed-width integer types for Morton keys and node links.
+#include <vector>                  // Include STL vector for the tree and scratch columns.
+
+// Parameters of the mutual gravity between bodies.
+struct NBodySettings {
+    float gravityConstant = 1000.0f;  // G, in world units (pixels, mass units, seconds).
+    float theta = 0.5f;               // Opening angle: a cell is used as a whole when size / distance < theta (0 = exact).
+    float softening = 4.0f;           // Added to distances so close encounters stay finite.
+};
+
+// Mutual gravity between all bodies in O(n log n) with a Barnes–Hut quadtree rebuilt every step.
+// Bodies are sorted along a Morton curve with a parallel radix sort; the cells of the top levels are
+// then built as independent subtrees in parallel and stitched together, and every leaf walks the
+// tree in parallel, opening only the cells that are too close for their centre of mass to stand in.
+// The result is applied as a velocity change, so it adds up with the uniform field of `Planets`
+// already in the force columns. Results do not depend on the number of threads.
+class BarnesHutGravity {
+public:
+    explicit BarnesHutGravity(const NBodySettings& settings = NBodySettings()) : settings(settings) {}
+
+    void setSettings(const NBodySettings& value) { settings = value; }
+    const NBodySettings& getSettings() const { return settings; }
+
+    // Add the gravity of every body on every other over `deltaTime` to their velocities.
+    // `jobs` may be null to run serially.
+    void apply(BodyStore& bodies, float deltaTime, JobSystem* jobs);
+
+    std::size_t getNodeCount() const { return nodes.size(); }  // Cells of the last tree.
+
+private:
+    // Cell of the quadtree. Every cell covers the Morton-sorted bodies [begin, end).
+    struct Node {
+        float comX, comY;          // Centre of mass.
+        float mass;                // Total mass.
+        float size;                // Side of the square cell.
+        std::uint32_t begin, end;  // Sorted bodies inside the cell.
+        std::uint32_t child;       // First child (children are contiguous); unused for leaves.
+        std::uint32_t childCount;  // Number of non-empty children, 0 for a leaf.
+    };
+
+    void sortBodies(const BodyStore& bodies, JobSystem* jobs);  // Fill `keys`/`order` and the sorted columns.
+    void buildTree(JobSystem* jobs);                           // Fill `nodes` from the sorted bodies.
+    void buildNode(std::vector<Node>& out, std::uint32_t slot, std::uint32_t begin, std::uint32_t end,
+                   unsigned depth, float size, unsigned stopDepth);  // Recursive top-down build.
+    void evaluate(BodyStore& bodies, float deltaTime, JobSystem* jobs);  // Walk the tree for every leaf.
+
+    NBodySettings settings;
+    float rootX = 0.0f, rootY = 0.0f, rootSize = 1.0f;  // Square covering every body.
+    std::vector<std::uint32_t> keys, keysTmp;    // Morton keys, sorted.
+    std::vector<std::uint32_t> order, orderTmp;  // Body id of each sorted position.
+    std::vector<std::uint32_t> histograms;       // Radix sort: 256 counters per chunk.
+    std::vector<float> bounds;                   // Bounds of the body centres per chunk: min x, min y, max x, max y.
+    std::vector<float> sortedX, sortedY, sortedMass;  // Centre and mass of the bodies in sorted order.
+    std::vector<Node> nodes;                     // The tree, root first.
+    std::vector<std::uint32_t> leaves;           // Leaf cells, each walked once for all its bodies.
+    std::vector<std::vector<Node>> subtrees;     // Subtrees of the top cells, built in parallel.
+    std::vector<std::uint32_t> subtreeOffset;    // Where each subtree is copied in `nodes`.
+    std::vector<std::uint32_t> subtreeSlot;      // Slot of `nodes` holding each subtree root.
+};
+
+#endif // BARNES_HUT_H  // End of the include guard.
@@ -0,0 +1,90 @@
+#include "ContactCache.h"  // Include the header file for the ContactCache class.
+#include <algorithm>       // Include `std::sort`, `std::lower_bound`, `std::binary_search`, `std::unique`.
+
+// Order of the entries: by pair.
+static bool pairLess(const BodyPair& a, const BodyPair& b) {
+    return a < b;
+}
+
+// Binary search of a pair among the previous contacts.
+const ContactCache::Entry* ContactCache::find(const BodyPair& pair) const {
+    auto it = std::lower_bound(previous.begin(), previous.end(), pair,
+                               [](const Entry& entry, const BodyPair& key) { return pairLess(entry.pair, key); });
+    return it != previous.end() && it->pair == pair ? &*it : nullptr;
+}
+
+// Apply last step's impulses to the contacts that still hold.
+void ContactCache::warmStart(BodyStore& bodies) {
+    const std::size_t n = bodies.size();
+    for (Entry& entry : previous) {
+        entry.warmed = 0;
+        const std::size_t a = entry.pair.first;
+        const std::size_t b = entry.pair.second;
+        if (a >= n || b >= n || (bodies.sleeping[a] && bodies.sleeping[b])) continue;
+
+        Contact contact;
+        if (!collide(bodies, a, b, contact)) continue;  // Separated since: nothing to carry over.
+
+        // A sleeping side holds like a static body, as in `Object::resolveCollision`: the warm start must not
+        // set it moving without waking it, so only the awake side takes the impulse.
+        const sf::Vector2f impulse = entry.normal * entry.impulse;
+        const float invA = bodies.sleeping[a] ? 0.0f : bodies.invMass[a];
+        const float invB = bodies.sleeping[b] ? 0.0f : bodies.invMass[b];
+        bodies.velX[a] -= impulse.x * invA;
+        bodies.velY[a] -= impulse.y * invA;
+        bodies.velX[b] += impulse.x * invB;
+        bodies.velY[b] += impulse.y * invB;
+        entry.warmed = 1;
+    }
+}
+
+// Load the warm start of a pair that was already touching.
+void ContactCache::prepare(const BodyPair& pair, Contact& contact) const {
+    const Entry* entry = find(pair);
+    contact.persistent = entry != nullptr;
+    contact.impulse = entry && entry->warmed ? entry->impulse : 0.0f;  // Only what `warmStart` already applied.
+}
+
+// Size the slots of this step.
+void ContactCache::begin(std::size_t slotCount) {
+    current.resize(slotCount);
+    touched.assign(slotCount, 0);
+}
+
+// Keep this step's contacts (plus those of sleeping pairs) for the next step, and wake the bodies of the
+// contacts that are gone.
+void ContactCache::end(BodyStore& bodies) {
+    next.clear();  // Keeps the allocated capacity.
+    for (std::size_t slot = 0; slot < touched.size(); ++slot) {
+        if (touched[slot]) next.push_back(current[slot]);
+    }
+    const std::size_t n = bodies.size();
+    for (const Entry& entry : previous) {
+        const std::size_t a = entry.pair.first;
+        const std::size_t b = entry.pair.second;
+        if (a < n && b < n && bodies.sleeping[a] && bodies.sleeping[b]) {
+            next.push_back(entry);
+        }
+    }
+
+    // Sorted by pair for the lookups; a pair recorded twice keeps its first record.
+    std::stable_sort(next.begin(), next.end(), [](const Entry& x, const Entry& y) { return pairLess(x.pair, y.pair); });
+    next.erase(std::unique(next.begin(), next.end(), [](const Entry& x, const Entry& y) { return x.pair == y.pair; }),
+               next.end());
+
+    // A contact that broke may have been holding a sleeping body up (its partner was knocked away or shrank):
+    // nothing else would touch that body again, so wake both sides and let them fall or settle anew.
+    for (const Entry& entry : previous) {
+        const std::size_t a = entry.pair.first;
+        const std::size_t b = entry.pair.second;
+        if (a >= n || b >= n) continue;
+        const bool kept = std::binary_search(next.begin(), next.end(), entry,
+                                             [](const Entry& x, const Entry& y) { return pairLess(x.pair, y.pair); });
+        if (!kept) {
+            bodies.wake(a);
+            bodies.wake(b);
+        }
+    }
+    previous.swap(next);
+    touched.clear();
+}
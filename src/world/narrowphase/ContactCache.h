@@ -0,0 +1,59 @@
+#ifndef CONTACT_CACHE_H  // Include guard to prevent multiple inclusions of this header file.
+#define CONTACT_CACHE_H  // Define the macro `CONTACT_CACHE_H` to ensure the file is included only once.
+
+#include "Narrowphase.h"                // Include the `Contact` records that are cached.
+#include "../broadphase/Broadphase.h"   // Include `BodyPair`, the key of the cache.
+#include <cstddef>                      // Include `std::size_t`.
+#include <cstdint>                      // Include fixed-width integer types for the slot flags.
+#include <vector>                       // Include STL vector for the sorted contact list.
+
+// Contacts of the previous step, keyed by body pair.
+// A pair found touching again is a persistent contact rather than a new impact: it is warm-started with
+// the normal impulse it needed last step, solved without restitution, and leaves no new debris. The
+// contacts are kept in a vector sorted by pair, so lookups during resolution are read-only binary searches
+// that any number of threads can run at once, and each step's contacts are recorded in a slot per pair.
+class ContactCache {
+public:
+    // Apply the impulse of every cached contact whose bodies still overlap, along its cached normal, before
+    // the pairs are solved. Serial; a sleeping body takes none of it, so pairs of two sleeping bodies are left alone.
+    void warmStart(BodyStore& bodies);
+
+    // Mark `contact` as persistent and load its warm-start impulse if the pair touched in the previous step.
+    // Thread-safe.
+    void prepare(const BodyPair& pair, Contact& contact) const;
+
+    // Start recording the contacts of this step, one slot per candidate pair.
+    void begin(std::size_t slotCount);
+
+    // Record the resolved contact of slot `slot`. Thread-safe for distinct slots.
+    void record(std::size_t slot, const BodyPair& pair, const Contact& contact) {
+        current[slot] = {pair, contact.normal, contact.impulse, 0};
+        touched[slot] = 1;
+    }
+
+    // Replace the previous contacts by the recorded ones. Contacts between two bodies that are both asleep
+    // (which the broadphase no longer pairs) are kept, so they do not count as new impacts when they wake.
+    // Both bodies of a contact that is gone are woken, so a body resting on it does not hang in the air.
+    void end(BodyStore& bodies);
+
+    void clear() { previous.clear(); }                  // Forget every contact.
+    std::size_t size() const { return previous.size(); } // Contacts kept from the last step.
+
+private:
+    // Contact of a pair as kept between steps.
+    struct Entry {
+        BodyPair pair;
+        sf::Vector2f normal;      // Normal of the last contact, from the first body to the second.
+        float impulse;            // Normal impulse accumulated by the pair.
+        std::uint8_t warmed;      // Whether `warmStart` applied the impulse this step.
+    };
+
+    const Entry* find(const BodyPair& pair) const;  // Entry of a pair, or null.
+
+    std::vector<Entry> previous;             // Contacts of the previous step, sorted by pair.
+    std::vector<Entry> current;              // Contacts of this step, by slot.
+    std::vector<std::uint8_t> touched;       // Per slot: whether a contact was recorded.
+    std::vector<Entry> next;                 // Contacts being gathered by `end`, swapped into `previous`.
+};
+
+#endif // CONTACT_CACHE_H  // End of the include guard.
@@ -0,0 +1,256 @@
+#include "Narrowphase.h"                 // Include the header file for the narrowphase kernels.
+#include "../../obj/abs/ShapeTraits.h"  // Include the outlines of the shapes and the pair dispatch.
+#include <algorithm>                    // Include `std::min`, `std::clamp`.
+#include <array>                        // Include STL array for the polygon outlines.
+#include <cmath>                        // Include `std::sqrt`.
+#include <limits>                       // Include infinity for the least-overlap search.
+
+namespace {
+
+// Placement of a body: top-left corner and extent of its bounding box.
+struct Placement {
+    sf::Vector2f position;
+    sf::Vector2f extent;
+
+    sf::Vector2f center() const { return {position.x + extent.x / 2, position.y + extent.y / 2}; }
+    float radius() const { return extent.x / 2; }  // Circles are scaled uniformly: width = height = diameter.
+};
+
+float dot(sf::Vector2f a, sf::Vector2f b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+// Outline of a polygonal shape in world coordinates.
+template <ShapeKind Kind>
+std::array<sf::Vector2f, ShapeTraits<Kind>::pointCount> outline(const Placement& body) {
+    std::array<sf::Vector2f, ShapeTraits<Kind>::pointCount> points;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        points[i] = body.position + ShapeTraits<Kind>::point(i, body.extent);
+    }
+    return points;
+}
+
+// Unit normal of the edge from `p` to `q` (its sign does not matter to the axis tests).
+sf::Vector2f edgeNormal(sf::Vector2f p, sf::Vector2f q) {
+    const sf::Vector2f edge = q - p;
+    const float length = std::sqrt(dot(edge, edge));
+    return length > 0.0f ? sf::Vector2f(-edge.y / length, edge.x / length) : sf::Vector2f(1.0f, 0.0f);
+}
+
+// Interval covered by a polygon on an axis.
+template <std::size_t N>
+void project(const std::array<sf::Vector2f, N>& points, sf::Vector2f axis, float& lo, float& hi) {
+    lo = hi = dot(points[0], axis);
+    for (std::size_t i = 1; i < N; ++i) {
+        const float d = dot(points[i], axis);
+        lo = std::min(lo, d);
+        hi = std::max(hi, d);
+    }
+}
+
+// Separating axis step: compare the intervals of the first shape [loA, hiA] and the second [loB, hiB] on
+// `axis`. Returns false if they are apart (the shapes do not overlap); otherwise keeps the least overlap
+// seen so far in `depth`, with `normal` oriented from the first shape to the second.
+bool overlapOnAxis(sf::Vector2f axis, float loA, float hiA, float loB, float hiB, float& depth, sf::Vector2f& normal) {
+    const float forward = hiA - loB;   // Overlap if the second shape lies on the positive side.
+    const float backward = hiB - loA;  // Overlap if it lies on the negative side.
+    if (forward <= 0.0f || backward <= 0.0f) return false;
+    if (forward < depth) {
+        depth = forward;
+        normal = axis;
+    }
+    if (backward < depth) {
+        depth = backward;
+        normal = -axis;
+    }
+    return true;
+}
+
+// Circle–circle: the centers are closer than the sum of the radii.
+bool circleCircle(const Placement& a, const Placement& b, Contact& contact) {
+    const sf::Vector2f d = b.center() - a.center();
+    const float reach = a.radius() + b.radius();
+    const float distance2 = dot(d, d);
+    if (distance2 >= reach * reach) return false;
+
+    const float distance = std::sqrt(distance2);
+    contact.normal = distance > 0.0f ? d / distance : sf::Vector2f(0.0f, 1.0f);  // Same center: push vertically.
+    contact.depth = reach - distance;
+    return true;
+}
+
+// Circle–square: distance from the center to the closest point of the box.
+bool circleBox(const Placement& a, const Placement& b, Contact& contact) {
+    const sf::Vector2f center = a.center();
+    const float radius = a.radius();
+    const sf::Vector2f lo = b.position;
+    const sf::Vector2f hi = b.position + b.extent;
+    const sf::Vector2f closest(std::clamp(center.x, lo.x, hi.x), std::clamp(center.y, lo.y, hi.y));
+    const sf::Vector2f d = closest - center;
+    const float distance2 = dot(d, d);
+
+    if (distance2 > 0.0f) {  // Center outside the box: the contact is at the closest point.
+        if (distance2 >= radius * radius) return false;
+        const float distance = std::sqrt(distance2);
+        contact.normal = d / distance;
+        contact.depth = radius - distance;
+        return true;
+    }
+
+    // Center inside the box: leave through the nearest side (the box lies on the opposite side).
+    float depth = center.x - lo.x;
+    sf::Vector2f normal(1.0f, 0.0f);
+    if (hi.x - center.x < depth) {
+        depth = hi.x - center.x;
+        normal = {-1.0f, 0.0f};
+    }
+    if (center.y - lo.y < depth) {
+        depth = center.y - lo.y;
+        normal = {0.0f, 1.0f};
+    }
+    if (hi.y - center.y < depth) {
+        depth = hi.y - center.y;
+        normal = {0.0f, -1.0f};
+    }
+    contact.normal = normal;
+    contact.depth = depth + radius;
+    return true;
+}
+
+// Circle–polygon: separating axes are the edge normals plus the axis towards the closest vertex.
+template <ShapeKind Kind>
+bool circlePolygon(const Placement& a, const Placement& b, Contact& contact) {
+    const auto points = outline<Kind>(b);
+    const sf::Vector2f center = a.center();
+    const float radius = a.radius();
+    float depth = std::numeric_limits<float>::infinity();
+    sf::Vector2f normal(1.0f, 0.0f);
+
+    auto test = [&](sf::Vector2f axis) {
+        float lo, hi;
+        project(points, axis, lo, hi);
+        const float c = dot(center, axis);
+        return overlapOnAxis(axis, c - radius, c + radius, lo, hi, depth, normal);
+    };
+
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        if (!test(edgeNormal(points[i], points[(i + 1) % points.size()]))) return false;
+    }
+
+    // Near a corner, only the axis through the closest vertex separates the circle from the polygon.
+    std::size_t nearest = 0;
+    float nearest2 = std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const sf::Vector2f d = points[i] - center;
+        if (dot(d, d) < nearest2) {
+            nearest2 = dot(d, d);
+            nearest = i;
+        }
+    }
+    if (nearest2 > 0.0f) {
+        const float distance = std::sqrt(nearest2);
+        if (!test((points[nearest] - center) / distance)) return false;
+    }
+
+    contact.normal = normal;
+    contact.depth = depth;
+    return true;
+}
+
+// Polygon–polygon: separating axis test over the edge normals of both outlines.
+template <ShapeKind KindA, ShapeKind KindB>
+bool polygonPolygon(const Placement& a, const Placement& b, Contact& contact) {
+    const auto pointsA = outline<KindA>(a);
+    const auto pointsB = outline<KindB>(b);
+    float depth = std::numeric_limits<float>::infinity();
+    sf::Vector2f normal(1.0f, 0.0f);
+
+    auto test = [&](sf::Vector2f axis) {
+        float loA, hiA, loB, hiB;
+        project(pointsA, axis, loA, hiA);
+        project(pointsB, axis, loB, hiB);
+        return overlapOnAxis(axis, loA, hiA, loB, hiB, depth, normal);
+    };
+
+    for (std::size_t i = 0; i < pointsA.size(); ++i) {
+        if (!test(edgeNormal(pointsA[i], pointsA[(i + 1) % pointsA.size()]))) return false;
+    }
+    for (std::size_t i = 0; i < pointsB.size(); ++i) {
+        if (!test(edgeNormal(pointsB[i], pointsB[(i + 1) % pointsB.size()]))) return false;
+    }
+
+    contact.normal = normal;
+    contact.depth = depth;
+    return true;
+}
+
+// Square–square: the boxes are the shapes, so the bounding box contact is exact.
+bool boxBox(const Placement& a, const Placement& b, Contact& contact) {
+    float depth = std::numeric_limits<float>::infinity();
+    sf::Vector2f normal(1.0f, 0.0f);
+    if (!overlapOnAxis({1.0f, 0.0f}, a.position.x, a.position.x + a.extent.x, b.position.x,
+                       b.position.x + b.extent.x, depth, normal) ||
+        !overlapOnAxis({0.0f, 1.0f}, a.position.y, a.position.y + a.extent.y, b.position.y,
+                       b.position.y + b.extent.y, depth, normal)) {
+        return false;
+    }
+    contact.normal = normal;
+    contact.depth = depth;
+    return true;
+}
+
+// Kernel of a pair of shapes, chosen at compile time. Kernels are written with the shapes in
+// `ShapeKind` order; the other order swaps the bodies and flips the normal.
+template <ShapeKind KindA, ShapeKind KindB>
+bool collideShapes(const Placement& a, const Placement& b, Contact& contact) {
+    if constexpr (KindB < KindA) {
+        if (!collideShapes<KindB, KindA>(b, a, contact)) return false;
+        contact.normal = -contact.normal;
+        return true;
+    } else if constexpr (KindA == ShapeKind::Circle && KindB == ShapeKind::Circle) {
+        return circleCircle(a, b, contact);
+    } else if constexpr (KindA == ShapeKind::Circle && KindB == ShapeKind::Square) {
+        return circleBox(a, b, contact);
+    } else if constexpr (KindA == ShapeKind::Circle) {
+        return circlePolygon<KindB>(a, b, contact);
+    } else if constexpr (KindA == ShapeKind::Square && KindB == ShapeKind::Square) {
+        return boxBox(a, b, contact);
+    } else {
+        return polygonPolygon<KindA, KindB>(a, b, contact);
+    }
+}
+
+}  // namespace
+
+// Exact overlap test, dispatched once on the pair of shapes.
+bool collide(const BodyStore& bodies, std::size_t a, std::size_t b, Contact& contact) {
+    // Disjoint bounding boxes cannot hold overlapping shapes: most candidate pairs stop here.
+    if (!(bodies.minX[a] < bodies.maxX[b] && bodies.minX[b] < bodies.maxX[a] &&
+          bodies.minY[a] < bodies.maxY[b] && bodies.minY[b] < bodies.maxY[a])) {
+        return false;
+    }
+
+    const Placement first{{bodies.posX[a], bodies.posY[a]}, {bodies.extX[a], bodies.extY[a]}};
+    const Placement second{{bodies.posX[b], bodies.posY[b]}, {bodies.extX[b], bodies.extY[b]}};
+    return visitShapePair(bodies.kind[a], bodies.kind[b], [&](auto shapeA, auto shapeB) {
+        return collideShapes<decltype(shapeA)::value, decltype(shapeB)::value>(first, second, contact);
+    });
+}
+
+// Contact of the bounding boxes along the axis of least overlap, oriented from `a` to `b`.
+Contact boxContact(const BodyStore& bodies, std::size_t a, std::size_t b) {
+    const float overlapX = std::min(bodies.maxX[a] - bodies.minX[b], bodies.maxX[b] - bodies.minX[a]);
+    const float overlapY = std::min(bodies.maxY[a] - bodies.minY[b], bodies.maxY[b] - bodies.minY[a]);
+    const float dx = (bodies.minX[b] + bodies.maxX[b]) - (bodies.minX[a] + bodies.maxX[a]);  // Twice the center offset.
+    const float dy = (bodies.minY[b] + bodies.maxY[b]) - (bodies.minY[a] + bodies.maxY[a]);
+
+    Contact contact;
+    if (overlapX < overlapY) {
+        contact.normal = {dx < 0.0f ? -1.0f : 1.0f, 0.0f};
+        contact.depth = overlapX;
+    } else {
+        contact.normal = {0.0f, dy < 0.0f ? -1.0f : 1.0f};
+        contact.depth = overlapY;
+    }
+    return contact;
+}
@@ -0,0 +1,25 @@
+#ifndef NARROWPHASE_H  // Include guard to prevent multiple inclusions of this header file.
+#define NARROWPHASE_H  // Define the macro `NARROWPHASE_H` to ensure the file is included only once.
+
+#include <SFML/Graphics.hpp>  // Include SFML vectors for the contact normal.
+#include "../BodyStore.h"     // Include the body store whose shapes are tested.
+#include <cstddef>            // Include `std::size_t`.
+
+// Contact between two bodies, as found by the narrowphase and used by the collision response.
+struct Contact {
+    sf::Vector2f normal;      // Unit normal pointing from the first body to the second.
+    float depth = 0.0f;       // Penetration depth along the normal.
+    float impulse = 0.0f;     // Normal impulse of the pair: the warm start going in, the accumulated total coming out.
+    bool persistent = false;  // Whether the pair was already touching in the previous step (not a new impact).
+};
+
+// Exact overlap test of two bodies of `bodies`, with one kernel per pair of shapes: circle–circle,
+// circle–square, circle–triangle (separating axes plus the closest-vertex axis), square–square (boxes) and
+// the separating axis test for the polygon pairs. Fills the normal and depth of `contact` when they overlap.
+// Reads the stored state only, so disjoint pairs can be tested concurrently.
+bool collide(const BodyStore& bodies, std::size_t a, std::size_t b, Contact& contact);
+
+// Contact of the bounding boxes of two bodies, along the axis of least overlap (depth <= 0 when apart).
+Contact boxContact(const BodyStore& bodies, std::size_t a, std::size_t b);
+
+#endif // NARROWPHASE_H  // End of the include guard.
@@ -0,0 +1,113 @@
+#include "../src/snapshot/Snapshot.h"  // Include the snapshot format under test.
+#include <cstdio>                        // Include `std::remove` for the temporary files.
+#include <cstring>                       // Include `std::memcmp` for bitwise comparisons.
+#include <filesystem>                    // Include the temporary directory.
+#include <fstream>                       // Include file streams to truncate a snapshot.
+#include <iostream>                      // Include console output for the failures.
+#include <random>                        // Include the seeded generator of the scene.
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Whether two columns hold the same bytes (so NaN payloads and negative zeros count too).
+template <typename T>
+bool sameColumn(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+bool sameDebris(const Debris& a, const Debris& b) {
+    return a.kind == b.kind && a.position == b.position && a.extent == b.extent && a.color == b.color;
+}
+
+}  // namespace
+
+// Write a seeded scene, read it back and compare every column, then check that a truncated file is rejected.
+int main() {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(0.5f, 40.0f);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    BodyStore bodies;
+    for (int i = 0; i < 1000; ++i) {
+        const ShapeKind kind = static_cast<ShapeKind>(i % 3);
+        const sf::Color color(byte(rng), byte(rng), byte(rng), byte(rng));
+        const std::size_t id = bodies.add(kind, {coordinate(rng), coordinate(rng)}, {size(rng), size(rng)}, color);
+        bodies.velX[id] = coordinate(rng);
+        bodies.velY[id] = coordinate(rng);
+        bodies.accX[id] = coordinate(rng);
+        bodies.accY[id] = coordinate(rng);
+        bodies.setMass(id, size(rng));
+        bodies.scale(id, 0.95f);
+        bodies.sleeping[id] = static_cast<std::uint8_t>(i % 2);
+        bodies.stillFrames[id] = static_cast<std::uint16_t>(i * 37);
+    }
+    std::vector<Debris> debris(333);
+    for (std::size_t i = 0; i < debris.size(); ++i) {
+        debris[i].kind = static_cast<ShapeKind>(i % 3);
+        debris[i].position = {coordinate(rng), coordinate(rng)};
+        debris[i].extent = {size(rng), size(rng)};
+        debris[i].color = sf::Color(byte(rng), byte(rng), byte(rng), 64);
+    }
+    SnapshotInfo info;
+    info.step = 123456789012ull;
+    info.time = 2057.6;
+    info.worldSize = {1920.0f, 1080.0f};
+    info.debrisCapacity = 500;
+    info.debrisAdded = 4321;
+    info.debrisEvicted = 3988;
+
+    const std::string path = (std::filesystem::temp_directory_path() / "engn_snapshot_test.snap").string();
+    check(writeSnapshot(path, bodies, debris, info), "write the snapshot");
+
+    BodyStore loaded;
+    std::vector<Debris> loadedDebris;
+    SnapshotInfo loadedInfo;
+    check(readSnapshot(path, loaded, loadedDebris, loadedInfo), "read the snapshot");
+
+    check(loaded.size() == bodies.size(), "body count");
+    check(sameColumn(loaded.posX, bodies.posX) && sameColumn(loaded.posY, bodies.posY), "positions");
+    check(sameColumn(loaded.velX, bodies.velX) && sameColumn(loaded.velY, bodies.velY), "velocities");
+    check(sameColumn(loaded.accX, bodies.accX) && sameColumn(loaded.accY, bodies.accY), "accelerations");
+    check(sameColumn(loaded.mass, bodies.mass) && sameColumn(loaded.invMass, bodies.invMass), "masses");
+    check(sameColumn(loaded.extX, bodies.extX) && sameColumn(loaded.extY, bodies.extY), "extents");
+    check(sameColumn(loaded.scaleFactor, bodies.scaleFactor), "scale factors");
+    check(sameColumn(loaded.minX, bodies.minX) && sameColumn(loaded.maxY, bodies.maxY), "bounds");
+    check(sameColumn(loaded.sleeping, bodies.sleeping), "sleep flags");
+    check(sameColumn(loaded.stillFrames, bodies.stillFrames), "still frames");
+    check(sameColumn(loaded.kind, bodies.kind), "shape kinds");
+    check(loaded.color == bodies.color, "colors");
+
+    bool debrisMatches = loadedDebris.size() == debris.size();
+    for (std::size_t i = 0; debrisMatches && i < debris.size(); ++i) {
+        debrisMatches = sameDebris(loadedDebris[i], debris[i]);
+    }
+    check(debrisMatches, "debris");
+
+    check(loadedInfo.step == info.step && loadedInfo.time == info.time, "step and time");
+    check(loadedInfo.worldSize == info.worldSize, "world size");
+    check(loadedInfo.debrisCapacity == info.debrisCapacity && loadedInfo.debrisAdded == info.debrisAdded &&
+          loadedInfo.debrisEvicted == info.debrisEvicted, "debris counters");
+
+    // A snapshot cut short must be rejected without touching the outputs.
+    const std::uintmax_t fullSize = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, fullSize - 100);
+    BodyStore untouched;
+    untouched.add(ShapeKind::Square, {1.0f, 2.0f}, {3.0f, 4.0f}, sf::Color::Red);
+    check(!readSnapshot(path, untouched, loadedDebris, loadedInfo), "reject a truncated snapshot");
+    check(untouched.size() == 1 && loadedDebris.size() == debris.size(), "keep the outputs of a failed read");
+
+    std::remove(path.c_str());
+    if (failures == 0) {
+        std::cout << "Snapshot round trip: OK" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+#include "../src/statelog/StateLog.h"  // Include the state log format under test.
+#include <cmath>                         // Include `std::lround` for the expected quantized positions.
+#include <cstdio>                        // Include `std::remove` for the temporary file.
+#include <filesystem>                    // Include the temporary directory.
+#include <iostream>                      // Include console output for the failures.
+#include <random>                        // Include the seeded generator of the motion.
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// What the replay must rebuild after one logged frame.
+struct ExpectedFrame {
+    std::vector<std::int32_t> x, y;    // Quantized positions.
+    std::vector<ShapeKind> kind;
+    std::vector<float> width, height;
+    std::vector<sf::Color> color;
+    std::vector<Debris> debris;        // Live debris, oldest first.
+    unsigned repeat = 1;
+};
+
+ExpectedFrame expect(const BodyStore& bodies, const DebrisPool& debris, unsigned repeat) {
+    ExpectedFrame frame;
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        frame.x.push_back(static_cast<std::int32_t>(std::lround(bodies.posX[i] * STATE_LOG_QUANTUM)));
+        frame.y.push_back(static_cast<std::int32_t>(std::lround(bodies.posY[i] * STATE_LOG_QUANTUM)));
+    }
+    frame.kind = bodies.kind;
+    frame.width = bodies.extX;
+    frame.height = bodies.extY;
+    frame.color = bodies.color;
+    debris.copyRecords(frame.debris);
+    frame.repeat = repeat;
+    return frame;
+}
+
+bool sameDebris(const std::vector<Debris>& a, const std::vector<Debris>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].kind != b[i].kind || a[i].position != b[i].position || a[i].extent != b[i].extent ||
+            a[i].color != b[i].color) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Keep the first `count` bodies of a store (`BodyStore` has no removal).
+BodyStore firstBodies(const BodyStore& bodies, std::size_t count) {
+    BodyStore kept;
+    for (std::size_t i = 0; i < count; ++i) {
+        kept.add(bodies.kind[i], {bodies.posX[i], bodies.posY[i]}, {bodies.extX[i], bodies.extY[i]}, bodies.color[i]);
+    }
+    return kept;
+}
+
+}  // namespace
+
+// Record a run whose bodies move, appear, shrink, change color and disappear while debris is evicted, then
+// replay the log and compare every frame with what was recorded.
+int main() {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> jump(-5000.0f, 5000.0f);  // Deltas of several varint bytes.
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    const double fps = 30.0;
+    const std::size_t debrisCapacity = 16;
+    const std::string path = (std::filesystem::temp_directory_path() / "engn_state_log_test.slog").string();
+
+    StateLogSettings settings;
+    settings.path = path;
+    settings.fps = fps;
+    StateRecorder recorder(settings);
+    check(recorder.open({640.0f, 480.0f}, debrisCapacity), "open the log");
+
+    BodyStore bodies;
+    DebrisPool debris(debrisCapacity);
+    std::vector<ExpectedFrame> frames;
+    for (int frame = 0; frame < 60; ++frame) {
+        if (frame % 10 == 0) {  // New bodies join.
+            for (int k = 0; k < 25; ++k) {
+                bodies.add(static_cast<ShapeKind>(k % 3), {jump(rng), jump(rng)}, {10.0f, 12.0f}, sf::Color::Green);
+            }
+        }
+        if (frame == 35) {
+            bodies = firstBodies(bodies, bodies.size() / 2);  // Bodies leave.
+        }
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            bodies.move(i, {step(rng), step(rng)});
+        }
+        bodies.setPosition(frame % bodies.size(), {jump(rng), jump(rng)});
+        bodies.scale((frame * 7) % bodies.size(), 0.95f);                       // Shrinks: restyled.
+        bodies.color[(frame * 13) % bodies.size()] = sf::Color(byte(rng), byte(rng), byte(rng));
+
+        for (int d = 0; d < 1 + frame % 7; ++d) {  // Up to 7 pieces a frame: the pool of 16 evicts.
+            Debris piece;
+            piece.kind = static_cast<ShapeKind>(d % 3);
+            piece.position = {jump(rng), jump(rng)};
+            piece.extent = {5.0f, 6.0f};
+            piece.color = sf::Color(byte(rng), byte(rng), byte(rng), 64);
+            debris.add(piece);
+        }
+
+        const unsigned repeat = frame == 20 ? 3 : 1;  // A long step covers several video frames.
+        recorder.update(static_cast<float>(repeat / fps) + 1e-6f, bodies, debris);
+        frames.push_back(expect(bodies, debris, repeat));
+    }
+    check(recorder.debrisMissed() == 0, "collect every piece of debris");
+    recorder.close();
+
+    StateLogReader reader;
+    check(reader.open(path), "open the log for reading");
+    check(reader.header().worldSize == sf::Vector2f(640.0f, 480.0f), "world size");
+    check(reader.header().debrisCapacity == debrisCapacity, "debris capacity");
+
+    ReplayState state;
+    DebrisPool replayed(static_cast<std::size_t>(reader.header().debrisCapacity));
+    std::size_t read = 0;
+    while (read < frames.size() && reader.next(state)) {
+        for (const Debris& piece : state.newDebris) {
+            replayed.add(piece);
+        }
+        const ExpectedFrame& expected = frames[read];
+        check(state.repeat == expected.repeat, "repeat count");
+        check(state.x == expected.x && state.y == expected.y, "quantized positions");
+        check(state.bodies.kind == expected.kind && state.bodies.color == expected.color, "shapes and colors");
+        check(state.bodies.extX == expected.width && state.bodies.extY == expected.height, "sizes");
+        std::vector<Debris> live;
+        replayed.copyRecords(live);
+        check(sameDebris(live, expected.debris), "live debris");
+        ++read;
+    }
+    check(read == frames.size(), "frame count");
+    check(!reader.next(state), "end of the log");
+
+    // Debris evicted before the recorder collects it is counted, not silently dropped.
+    StateRecorder lossy(settings);
+    check(lossy.open({640.0f, 480.0f}, debrisCapacity), "open the lossy log");
+    DebrisPool burst(debrisCapacity);
+    lossy.update(static_cast<float>(1.0 / fps), bodies, burst);
+    for (std::size_t d = 0; d < debrisCapacity + 5; ++d) {  // More pieces in one step than the pool holds.
+        burst.add(Debris());
+    }
+    lossy.update(static_cast<float>(1.0 / fps), bodies, burst);
+    check(lossy.debrisMissed() == 5, "count the debris evicted before it was logged");
+    lossy.close();
+
+    std::remove(path.c_str());
+    if (failures == 0) {
+        std::cout << "State log round trip: OK (" << read << " frames)" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}